@@ -1,85 +1,427 @@
 #pragma once
 #include "ISolver.hpp"
+#include "ContractionHierarchy.hpp"
+#include "DeltaStepping.hpp"
+#include "Landmarks.hpp"
+#include "ParallelBfs.hpp"
+#include "PathTreeCache.hpp"
+#include "SolverWorkspace.hpp"
+#include "../core/DaryHeap.hpp"
+#include "../core/RadixHeap.hpp"
 #include <queue>
-#include <unordered_set>
-#include <unordered_map>
 #include <limits>
-#include "raymath.h"
 
 using PQElement = std::pair<float, int>;
 
+// Priority queue behind Dijkstra and A*.
+enum class QueueKind {
+    INDEXED_DARY,   // IndexedDaryHeap: one entry per node, decrease-key in place
+    LAZY_BINARY     // std::priority_queue: push duplicates, skip stale entries on pop
+};
+
+// BFS, DFS, Dijkstra, A* and the bidirectional searches keep their per-node
+// state in a SolverWorkspace borrowed from SolverWorkspacePool::Shared() on
+// the first Initialize and held until the solver is destroyed, so between
+// queries only the nodes a search touched cost anything.
+
 class BfsSolver : public ISolver {
 private:
-    std::deque<int> frontier;
-    std::unordered_set<int> visited;
-    std::unordered_map<int, int> parentMap;
+    // Discovered nodes go to the workspace's Reached() list in order; the
+    // queue is its tail from `head` on.
+    SolverWorkspacePool::Lease workspace;
+    size_t head = 0;
 
-    Graph* graph = nullptr;
-    int startNodeId = -1;
-    int endNodeId = -1;
+    const CsrGraph* csr = nullptr;
+    int startIndex = -1;
+    int endIndex = -1;
+    int expandedCount = 0;
 
 public:
-    void Initialize(Graph* graph, int start, int end) override;
+    using ISolver::Initialize;
+    void Initialize(const CsrGraph* graph, int start, int end) override;
     SolverState Step() override;
     std::vector<int> GetPath() const override;
+    int GetExpandedCount() const override { return expandedCount; }
 
-    void DrawDebug(Font font) override {};
+    void DrawDebug(IDebugCanvas& canvas) override {};
 };
 
-class DfsSolver : public ISolver {
+// Hop-count BFS on a ParallelBfs run: each Step expands a whole level, the
+// old frontier turning settled and the new one discovered. Stops after the
+// level that reaches the end node (or runs out of nodes when there is none).
+class ParallelBfsSolver : public ISolver {
 private:
-    std::vector<int> stack;
+    ParallelBfs engine;
+    std::vector<int> frontier;   // the level the next Step expands
+    std::vector<int> reached;    // for DrawDebug
 
-    std::unordered_set<int> visited;
-    std::unordered_map<int, int> parentMap;
+    const CsrGraph* csr = nullptr;
+    int startIndex = -1;
+    int endIndex = -1;
+    int expandedCount = 0;
 
-    Graph* graph = nullptr;
-    int startNodeId = -1;
-    int endNodeId = -1;
+public:
+    explicit ParallelBfsSolver(const ParallelBfsOptions& options = {}) : engine(options) {}
+
+    using ISolver::Initialize;
+    void Initialize(const CsrGraph* graph, int start, int end) override;
+    SolverState Step() override;
+    std::vector<int> GetPath() const override;
+    int GetExpandedCount() const override { return expandedCount; }
+    bool CanExportTree() const override { return true; }
+    bool ExportTree(ShortestPathTree& tree) const override;
+
+    void DrawDebug(IDebugCanvas& canvas) override;
+
+    // The underlying run, for one-to-all depth and parent arrays.
+    ParallelBfs& GetEngine() { return engine; }
+};
+
+class DfsSolver : public ISolver {
+private:
+    SolverWorkspacePool::Lease workspace;
+
+    const CsrGraph* csr = nullptr;
+    int startIndex = -1;
+    int endIndex = -1;
+    int expandedCount = 0;
 
 public:
-    void Initialize(Graph* graph, int start, int end) override;
+    using ISolver::Initialize;
+    void Initialize(const CsrGraph* graph, int start, int end) override;
     SolverState Step() override;
     std::vector<int> GetPath() const override;
+    int GetExpandedCount() const override { return expandedCount; }
 
-    void DrawDebug(Font font) override {}
+    void DrawDebug(IDebugCanvas& canvas) override {}
 };
 
 class DijkstraSolver : public ISolver {
 private:
+    QueueKind queueKind;
     std::priority_queue<PQElement, std::vector<PQElement>, std::greater<PQElement>> pq;
-    std::unordered_map<int, float> dist;
-    std::unordered_map<int, int> parentMap;
 
-    Graph* graph = nullptr;
-    int startNodeId = -1;
-    int endNodeId = -1;
+    // Distances, parents, the indexed heap and the discovery order (for
+    // DrawDebug), by CsrGraph index.
+    SolverWorkspacePool::Lease workspace;
+    float settledRadius = 0.0f; // key of the last node taken off the queue
+
+    const CsrGraph* csr = nullptr;
+    int startIndex = -1;
+    int endIndex = -1;
+    int expandedCount = 0;
 
 public:
-    void Initialize(Graph* graph, int start, int end) override;
+    explicit DijkstraSolver(QueueKind queueKind = QueueKind::INDEXED_DARY) : queueKind(queueKind) {}
+
+    using ISolver::Initialize;
+    void Initialize(const CsrGraph* graph, int start, int end) override;
     SolverState Step() override;
     std::vector<int> GetPath() const override;
+    int GetExpandedCount() const override { return expandedCount; }
+    bool CanExportTree() const override { return true; }
+    bool ExportTree(ShortestPathTree& tree) const override;
+
+    void DrawDebug(IDebugCanvas& canvas) override;
+};
 
-    void DrawDebug(Font font) override;
+// A*'s estimate of the remaining distance.
+enum class HeuristicKind {
+    EUCLIDEAN,   // straight line between node positions
+    LANDMARKS    // ALT lower bounds from a LandmarkTable; ignores positions
 };
 
 class AStarSolver : public ISolver {
 private:
+    QueueKind queueKind;
+    HeuristicKind heuristicKind;
+
+    const LandmarkTable* sharedLandmarks = nullptr;
+    LandmarkTable ownLandmarks;
+    const LandmarkTable* landmarks = nullptr;
     std::priority_queue<PQElement, std::vector<PQElement>, std::greater<PQElement>> pq;
-    std::unordered_map<int, float> gScore;
-    std::unordered_map<int, float> fScore;
-    std::unordered_map<int, int> parentMap;
 
-    Graph* graph = nullptr;
-    int startNodeId = -1;
-    int endNodeId = -1;
+    // g is the workspace distance, f its score.
+    SolverWorkspacePool::Lease workspace;
+
+    const CsrGraph* csr = nullptr;
+    int startIndex = -1;
+    int endIndex = -1;
+    int expandedCount = 0;
+
+    // Euclidean estimates of the neighbours of the node being expanded,
+    // by edge offset from EdgesBegin.
+    std::vector<float> neighborHeuristics;
 
-    float Heuristic(int nodeId);
+    float Heuristic(int u) const;
 
 public:
-    void Initialize(Graph* graph, int start, int end) override;
+    explicit AStarSolver(QueueKind queueKind = QueueKind::INDEXED_DARY,
+                         HeuristicKind heuristicKind = HeuristicKind::EUCLIDEAN)
+        : queueKind(queueKind), heuristicKind(heuristicKind) {}
+
+    // With LANDMARKS, uses `table` for graphs it matches instead of building
+    // its own on the first Initialize for a graph. Must outlive the runs.
+    void SetLandmarks(const LandmarkTable* table) { sharedLandmarks = table; }
+
+    using ISolver::Initialize;
+    void Initialize(const CsrGraph* graph, int start, int end) override;
     SolverState Step() override;
     std::vector<int> GetPath() const override;
+    int GetExpandedCount() const override { return expandedCount; }
+
+    void DrawDebug(IDebugCanvas& canvas) override;
+};
+
+// Dijkstra over integer distances on a RadixHeap. Edge weights are used as
+// exact integers when every weight of the graph is a non-negative integer.
+// Otherwise, with quantization enabled, they are rounded to a power-of-two
+// fixed-point grid with 2^20 steps up to the largest weight (paths may then
+// be off by the rounding); without it the run falls back to DijkstraSolver.
+// The choice is made once per snapshot, on the first Initialize after it
+// changes.
+class RadixDijkstraSolver : public ISolver {
+public:
+    enum class Mode {
+        EXACT,
+        QUANTIZED,
+        FALLBACK
+    };
+
+private:
+    bool allowQuantization;
+    DijkstraSolver fallback;
+    Mode mode = Mode::FALLBACK;
+
+    uint64_t preparedBuildId = 0;
+    std::vector<uint32_t> keyWeights;   // per CSR edge, in units of `quantum`
+    float quantum = 1.0f;
+
+    RadixHeap<int> heap;
+    std::vector<uint64_t> dist;
+    std::vector<int> parent;
+    std::vector<int> reached;
+
+    const CsrGraph* csr = nullptr;
+    int startIndex = -1;
+    int endIndex = -1;
+    int expandedCount = 0;
+
+    void PrepareWeights();
+
+public:
+    explicit RadixDijkstraSolver(bool allowQuantization = false) : allowQuantization(allowQuantization) {}
+
+    using ISolver::Initialize;
+    void Initialize(const CsrGraph* graph, int start, int end) override;
+    SolverState Step() override;
+    std::vector<int> GetPath() const override;
+    int GetExpandedCount() const override;
+
+    void DrawDebug(IDebugCanvas& canvas) override;
+
+    // How the current run works; valid after Initialize.
+    Mode GetMode() const { return mode; }
+};
+
+// Dijkstra from both ends at once: forward from the start on the CSR and
+// backward from the end on its reverse, so directed edges are followed the
+// right way on each side. Every Step settles one node on the side whose
+// queue top is smaller. `bestDistance` is the shortest start-end path seen
+// through any relaxed edge; once the two queue tops add up to at least that,
+// no path still unseen can be shorter and the search stops.
+//
+// Subclasses can supply a potential p: the forward side orders its queue by
+// dist + p(v), the backward side by dist - p(v). For a p that keeps both
+// sides consistent the same stopping rule holds on those keys.
+class BidirectionalSearch : public ISolver {
+private:
+    struct Side {
+        const CsrGraph* graph = nullptr;
+        SolverWorkspacePool::Lease workspace;
+    };
+
+    Side sides[2];   // 0 = forward, 1 = backward
+
+    CsrGraph reverse;
+    uint64_t reverseSourceId = 0;
+
+    float bestDistance = 0.0f;
+    int meetingNode = -1;
+    int expandedCount = 0;
+
+    void Expand(int side);
+
+protected:
+    const CsrGraph* csr = nullptr;
+    int startIndex = -1;
+    int endIndex = -1;
 
-    void DrawDebug(Font font) override;
-};
\ No newline at end of file
+    virtual float Potential(int /*u*/) const { return 0.0f; }
+
+public:
+    using ISolver::Initialize;
+    void Initialize(const CsrGraph* graph, int start, int end) override;
+    SolverState Step() override;
+    std::vector<int> GetPath() const override;
+    int GetExpandedCount() const override { return expandedCount; }
+
+    void DrawDebug(IDebugCanvas& canvas) override;
+};
+
+class BidirectionalDijkstraSolver : public BidirectionalSearch {};
+
+// Averaged straight-line potential p(v) = (|v, end| - |start, v|) / 2, which
+// stays consistent in both directions whenever A*'s heuristic is.
+class BidirectionalAStarSolver : public BidirectionalSearch {
+protected:
+    float Potential(int u) const override;
+};
+
+// Point-to-point queries on a ContractionHierarchy: a forward search from the
+// start along upward edges and a backward one from the end along downward
+// edges, alternating by queue top. A side stops once its top reaches the best
+// meeting distance. "Stall-on-demand" skips expanding a node that a higher,
+// already reached node gets to more cheaply: it cannot lie on a shortest
+// up-down path.
+//
+// Uses the hierarchy given to SetHierarchy when it matches the graph;
+// otherwise builds (and keeps) its own on the first Initialize for a graph.
+class ChSolver : public ISolver {
+private:
+    struct Side {
+        IndexedDaryHeap<float> heap;
+        std::vector<float> dist;
+        std::vector<int> parent;
+        std::vector<int> reached;
+    };
+
+    Side sides[2];   // 0 = forward (upward edges), 1 = backward (downward edges)
+
+    const ContractionHierarchy* shared = nullptr;
+    ContractionHierarchy own;
+    const ContractionHierarchy* hierarchy = nullptr;
+
+    const CsrGraph* csr = nullptr;
+    int startIndex = -1;
+    int endIndex = -1;
+    float bestDistance = 0.0f;
+    int meetingNode = -1;
+    int expandedCount = 0;
+
+    bool IsStalled(int side, int u) const;
+    void Expand(int side);
+
+public:
+    // `hierarchy` must outlive every run that uses it; nullptr clears it.
+    void SetHierarchy(const ContractionHierarchy* hierarchy) { shared = hierarchy; }
+
+    using ISolver::Initialize;
+    void Initialize(const CsrGraph* graph, int start, int end) override;
+    SolverState Step() override;
+    std::vector<int> GetPath() const override;
+    int GetExpandedCount() const override { return expandedCount; }
+
+    void DrawDebug(IDebugCanvas& canvas) override;
+};
+
+// Dijkstra's distances from a parallel DeltaStepping run. Each Step expands
+// one bucket and reports the nodes it settled; the search stops once the end
+// node's bucket is done (or covers the whole graph when there is no end).
+class DeltaSteppingSolver : public ISolver {
+private:
+    DeltaStepping engine;
+    std::vector<int> reached;   // settled nodes, for DrawDebug
+
+    const CsrGraph* csr = nullptr;
+    int startIndex = -1;
+    int endIndex = -1;
+    int expandedCount = 0;
+
+public:
+    explicit DeltaSteppingSolver(const DeltaSteppingOptions& options = {}) : engine(options) {}
+
+    using ISolver::Initialize;
+    void Initialize(const CsrGraph* graph, int start, int end) override;
+    SolverState Step() override;
+    std::vector<int> GetPath() const override;
+    int GetExpandedCount() const override { return expandedCount; }
+    bool CanExportTree() const override { return true; }
+    bool ExportTree(ShortestPathTree& tree) const override;
+
+    void DrawDebug(IDebugCanvas& canvas) override;
+
+    // The underlying run, for one-to-all distance and parent arrays.
+    DeltaStepping& GetEngine() { return engine; }
+};
+
+// Lifelong Planning A* (Koenig & Likhachev): A* that keeps its search across
+// runs. Every node has g, the distance it was last expanded with, and rhs,
+// the best distance its predecessors' g values offer; nodes where the two
+// differ are queued by [min(g, rhs) + h, min(g, rhs)]. A node whose rhs fell
+// below g is settled at rhs, like A*; one whose rhs rose above it is reset to
+// infinity and its children re-derive theirs. The search is done once the
+// end node agrees with itself and nothing queued sorts before it.
+//
+// Initialize with the same start on the next build of the same snapshot
+// (CsrGraph::GetPreviousBuildId) only re-derives rhs at the heads of the
+// changed edges and then repairs outwards from there, so a few edits cost
+// about as much as the part of the tree they change. A different end node
+// just re-keys the queue. Anything else (new start, unknown history) starts
+// over. Steps report settled nodes and, as discovered, the ones that went
+// back on the queue.
+class LpaStarSolver : public ISolver {
+private:
+    struct Key {
+        float estimate;   // min(g, rhs) + h
+        float distance;   // min(g, rhs)
+
+        bool operator<(const Key& other) const {
+            return estimate < other.estimate || (estimate == other.estimate && distance < other.distance);
+        }
+    };
+
+    IndexedDaryHeap<Key> heap;
+    std::vector<float> g;
+    std::vector<float> rhs;
+    std::vector<int> parent;     // the predecessor rhs comes from
+    std::vector<char> touched;
+    std::vector<int> reached;    // every node that ever had a finite rhs, for DrawDebug
+
+    // Predecessors, built only once some rhs has to be re-derived.
+    CsrGraph reverse;
+    uint64_t reverseSourceId = 0;
+
+    const CsrGraph* csr = nullptr;
+    uint64_t searchedBuildId = 0;   // the snapshot g and rhs belong to
+    int startIndex = -1;
+    int endIndex = -1;
+    int expandedCount = 0;
+    int changeCount = 0;
+    bool repaired = false;
+    bool unreachable = false;   // ruled out by the connectivity index
+
+    float Heuristic(int u) const;
+    Key KeyOf(int u) const;
+
+    void Reset(int start);
+    void Resize(int nodeCount);
+    void ApplyChanges();
+    void Lower(int u, float value, int from);
+    void Rederive(int u);
+    void Requeue(int u);
+
+public:
+    using ISolver::Initialize;
+    void Initialize(const CsrGraph* graph, int start, int end) override;
+    SolverState Step() override;
+    std::vector<int> GetPath() const override;
+    int GetExpandedCount() const override { return expandedCount; }
+
+    void DrawDebug(IDebugCanvas& canvas) override;
+
+    // Whether the last Initialize kept the previous search, and how many
+    // edge edits it took over.
+    bool WasRepaired() const { return repaired; }
+    int GetChangeCount() const { return changeCount; }
+};
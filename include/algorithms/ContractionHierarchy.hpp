@@ -0,0 +1,126 @@
+#pragma once
+#include "../core/CsrGraph.hpp"
+#include "../core/GraphFile.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Contraction Hierarchies (Geisberger et al.) over a frozen CsrGraph.
+//
+// Preprocessing ranks every node and "contracts" them from the lowest rank
+// up: removing a node adds a shortcut u -> w for each u -> v -> w through it
+// that no other path (a "witness") can match. Queries then only ever move
+// to higher-ranked nodes: a forward search from the start on the upward
+// edges and a backward search from the end on the edges coming down into
+// each node meet at the highest node of some shortest path, after settling
+// a few hundred nodes even on continent-sized road networks.
+//
+// Contraction runs in rounds on a ThreadPool. Each round contracts the nodes
+// whose priority is lower than all their neighbors' (so no two of them are
+// adjacent); their witness searches avoid every node of the round, which
+// makes the round equivalent to contracting those nodes one at a time.
+// Priorities are updated lazily: a node whose neighborhood changed is only
+// re-evaluated when it next comes up as a local minimum, by the same search
+// that finds its shortcuts.
+//
+// The result can be written as extra graph file sections (GetSections) and
+// attached straight from a MappedGraphFile, like the CSR arrays themselves.
+
+// One edge of the hierarchy. In the upward lists of u, `node` is the higher
+// head of u -> node; in the downward lists of u it is the higher tail of
+// node -> u. `middle` is the node a shortcut bypasses, -1 for graph edges.
+struct ChEdge {
+    int32_t node;
+    float weight;
+    int32_t middle;
+};
+
+enum ChSectionTag : uint32_t {
+    SECTION_CH_INFO = SECTION_USER_BASE,    // ChFileInfo
+    SECTION_CH_RANKS,                       // int32[nodeCount], a permutation
+    SECTION_CH_UP_OFFSETS,                  // int32[nodeCount + 1]
+    SECTION_CH_UP_EDGES,                    // ChEdge[upEdgeCount]
+    SECTION_CH_DOWN_OFFSETS,                // int32[nodeCount + 1]
+    SECTION_CH_DOWN_EDGES                   // ChEdge[downEdgeCount]
+};
+
+constexpr uint32_t CH_FILE_VERSION = 1;
+
+struct ChFileInfo {
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t shortcutCount;
+};
+
+struct ChBuildOptions {
+    int threadCount = 0;              // 0 = one per hardware thread
+    int witnessSettleLimit = 500;     // give up (and add the shortcut) after this many nodes
+};
+
+struct ChBuildStats {
+    int rounds = 0;
+    uint64_t shortcutCount = 0;
+    double seconds = 0.0;
+};
+
+class ContractionHierarchy {
+private:
+    int nodeCount = 0;
+    int upEdgeCount = 0;
+    int downEdgeCount = 0;
+    uint64_t shortcutCount = 0;
+    uint64_t sourceBuildId = 0;
+
+    const int* ranks = nullptr;
+    const int* upOffsets = nullptr;
+    const ChEdge* upEdges = nullptr;
+    const int* downOffsets = nullptr;
+    const ChEdge* downEdges = nullptr;
+
+    std::vector<int> ownedRanks;
+    std::vector<int> ownedUpOffsets;
+    std::vector<ChEdge> ownedUpEdges;
+    std::vector<int> ownedDownOffsets;
+    std::vector<ChEdge> ownedDownEdges;
+    ChFileInfo info = {};
+
+    const ChEdge* FindEdge(int from, int to) const;
+
+public:
+    ContractionHierarchy() = default;
+    ContractionHierarchy(const ContractionHierarchy&) = delete;
+    ContractionHierarchy& operator=(const ContractionHierarchy&) = delete;
+
+    void Build(const CsrGraph& graph, const ChBuildOptions& options = {}, ChBuildStats* stats = nullptr);
+
+    // Borrows the hierarchy stored in `file`, which must stay open. Returns
+    // false (and leaves the hierarchy empty) if the file has none or it does
+    // not fit the file's graph.
+    bool Attach(const MappedGraphFile& file, std::string* error = nullptr);
+
+    void Clear();
+
+    // Sections for SaveGraphFile; they point into this hierarchy.
+    std::vector<GraphFileBlob> GetSections();
+
+    // True if this hierarchy was built from (or stored with) `graph`.
+    bool Matches(const CsrGraph& graph) const {
+        return ranks != nullptr && sourceBuildId == graph.GetBuildId();
+    }
+
+    int NodeCount() const { return nodeCount; }
+    uint64_t GetShortcutCount() const { return shortcutCount; }
+    int Rank(int u) const { return ranks[u]; }
+
+    int UpBegin(int u) const { return upOffsets[u]; }
+    int UpEnd(int u) const { return upOffsets[u + 1]; }
+    const ChEdge& UpEdge(int e) const { return upEdges[e]; }
+
+    int DownBegin(int u) const { return downOffsets[u]; }
+    int DownEnd(int u) const { return downOffsets[u + 1]; }
+    const ChEdge& DownEdge(int e) const { return downEdges[e]; }
+
+    // Appends the graph path of hierarchy edge from -> to, shortcuts
+    // expanded, excluding `from` itself. Dense indices.
+    void Unpack(int from, int to, std::vector<int>& path) const;
+};
@@ -0,0 +1,124 @@
+#pragma once
+#include "../core/CsrGraph.hpp"
+#include "../core/ThreadPool.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Parallel single-source shortest paths by delta-stepping (Meyer & Sanders).
+//
+// Tentative distances are filed into buckets of width delta instead of a
+// priority queue, and the whole lowest non-empty bucket is expanded at once
+// across a ThreadPool. Edges no heavier than delta ("light") can land back
+// in the same bucket, so it is re-expanded until it stays empty; the heavier
+// edges of everything it settled are relaxed once afterwards. A small delta
+// approaches Dijkstra (little wasted work, many sequential buckets), a large
+// one Bellman-Ford (lots of parallelism, many re-relaxations).
+//
+// Each node's distance and parent share one 64-bit word lowered with
+// compare-and-swap, so a parent always belongs to the distance stored with
+// it. Threads file the nodes they improve into buckets of their own, which
+// are merged between phases.
+//
+// Relaxing from bucket b reaches at most b + ceil(maxWeight / delta), so the
+// buckets are a ring of that many slots indexed modulo its size. The ring is
+// capped; entries past its end wait in an overflow list until it runs dry.
+struct DeltaSteppingOptions {
+    float delta = 0.0f;     // bucket width; 0 picks one from the weight distribution
+    int threadCount = 0;    // 0 = one per hardware thread
+};
+
+class DeltaStepping {
+private:
+    struct Worker {
+        std::vector<std::vector<int>> buckets;   // ring: bucket i in slot i % ringSize
+        std::vector<int> far;                    // nodes filed past the ring's end
+        std::vector<int> settled;
+    };
+
+    DeltaSteppingOptions options;
+    ThreadPool pool;
+    std::vector<Worker> workers;
+
+    // The graph's edges regrouped per node, light ones first. Rebuilt when
+    // the snapshot or delta changes.
+    const CsrGraph* graph = nullptr;
+    uint64_t splitBuildId = 0;
+    float splitDelta = 0.0f;
+    std::vector<int> lightEnd;
+    std::vector<int> targets;
+    std::vector<float> weights;
+    float maxWeight = 0.0f;
+
+    int nodeCount = 0;
+    std::unique_ptr<std::atomic<uint64_t>[]> state;     // distance bits << 32 | parent
+    std::unique_ptr<std::atomic<uint32_t>[]> expanded;  // last phase that expanded the node
+    std::unique_ptr<std::atomic<uint32_t>[]> settled;   // last bucket that settled the node
+    uint32_t phaseSerial = 0;
+    uint32_t bucketSerial = 0;
+
+    int target = -1;
+    float delta = 1.0f;
+    size_t bucket = 0;          // the bucket the next Step expands
+    size_t ringSize = 1;
+    bool finished = true;
+    int bucketCount = 0;
+    long long settledCount = 0;
+
+    std::vector<int> frontier;
+    std::vector<int> lastSettled;
+
+    bool materialized = false;
+    std::vector<float> distances;
+    std::vector<int> parents;
+
+    void SplitEdges();
+    size_t BucketOf(float distance) const;
+    void Relax(Worker& worker, int u, float du, int begin, int end);
+    void Gather(size_t index, std::vector<int>& out);
+    void ExpandFrontier(uint32_t phase, uint32_t bucketStamp);
+    bool FindNextBucket();
+    void Materialize();
+
+public:
+    explicit DeltaStepping(const DeltaSteppingOptions& options = {});
+
+    // Bucket width for `graph` from a sample of its edge weights: the weight
+    // below which a node has about two light edges on average, so buckets
+    // rarely re-expand much while staying wide enough to share out.
+    static float ChooseDelta(const CsrGraph& graph);
+
+    // Starts a search from dense index `source`. With a `target`, stops as
+    // soon as its distance is final and prunes anything at least that far;
+    // the other nodes then only hold upper bounds. `graph` must outlive it.
+    void Begin(const CsrGraph& graph, int source, int target = -1);
+
+    // Expands the next bucket: light phases until it stays empty, then its
+    // heavy edges. Returns false once the search is over.
+    bool Step();
+
+    // Begin plus Step until done.
+    void Run(const CsrGraph& graph, int source, int target = -1);
+
+    bool IsFinished() const { return finished; }
+    float GetDelta() const { return delta; }
+    int GetBucketCount() const { return bucketCount; }
+    long long GetSettledCount() const { return settledCount; }
+
+    // Nodes whose distance became final in the last Step.
+    const std::vector<int>& GetLastSettled() const { return lastSettled; }
+
+    // Live values; read them between Steps only.
+    float Distance(int u) const;
+    int Parent(int u) const;
+
+    // Distances no larger than this are final (infinity once every
+    // reachable node is).
+    float GetSettledRadius() const;
+
+    // Every node's distance (infinity if unreached) and parent (-1 for the
+    // source and unreached nodes), filled on first use after the search.
+    const std::vector<float>& GetDistances();
+    const std::vector<int>& GetParents();
+};
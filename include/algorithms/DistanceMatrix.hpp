@@ -0,0 +1,56 @@
+#pragma once
+#include "../core/CsrGraph.hpp"
+#include <string>
+#include <vector>
+
+// Many-to-many shortest path distances: one Dijkstra search per source,
+// each stopping as soon as every target has been settled, spread over a
+// ThreadPool. Each thread keeps one search workspace (heap, distances,
+// parents) and resets only the nodes its previous search reached.
+//
+// When there are fewer targets than sources the searches run backward from
+// the targets on the reverse CSR instead, so the matrix always costs
+// min(sources, targets) searches. Repeated sources or targets are searched
+// once.
+//
+// Pairs the snapshot's connectivity index (CsrGraph::MayReach) rules out are
+// left at infinity without being waited for, so a search stops after its
+// reachable targets; one with none left is not run at all.
+struct DistanceMatrixOptions {
+    int threadCount = 0;      // 0 = one per hardware thread
+    bool storePaths = false;  // keep the node ids of every shortest path
+};
+
+struct DistanceMatrixStats {
+    int searches = 0;
+    bool backward = false;    // searched from the targets
+    long long ruledOutPairs = 0;   // distinct source/target pairs never searched for
+    long long settledCount = 0;
+    double seconds = 0.0;
+};
+
+class DistanceMatrix {
+private:
+    int rowCount = 0;
+    int columnCount = 0;
+    std::vector<float> distances;           // row-major, infinity if unreachable
+    std::vector<std::vector<int>> paths;    // row-major, when storePaths
+
+public:
+    // Rows follow `sourceIds`, columns `targetIds` (Node ids). Returns false
+    // and fills `error` if an id is not in the graph.
+    bool Compute(const CsrGraph& graph, const std::vector<int>& sourceIds, const std::vector<int>& targetIds,
+                 const DistanceMatrixOptions& options = {}, DistanceMatrixStats* stats = nullptr,
+                 std::string* error = nullptr);
+    void Clear();
+
+    int RowCount() const { return rowCount; }
+    int ColumnCount() const { return columnCount; }
+
+    float Distance(int row, int column) const { return distances[static_cast<size_t>(row) * columnCount + column]; }
+    const std::vector<float>& GetDistances() const { return distances; }
+
+    // Node ids from source to target; empty if unreachable or paths were
+    // not stored.
+    const std::vector<int>& Path(int row, int column) const;
+};
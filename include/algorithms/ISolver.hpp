@@ -1,7 +1,10 @@
 #pragma once
 #include "../core/Graph.hpp"
+#include <cstdint>
 #include <vector>
 
+struct ShortestPathTree;
+
 enum class SolverState {
     NOT_STARTED,
     RUNNING,
@@ -9,14 +12,87 @@ enum class SolverState {
     FINISHED_NO_PATH
 };
 
+// Drawing surface for solver overlays. Keeps the solvers free of any
+// rendering dependency; the GUI provides a raylib implementation.
+class IDebugCanvas {
+public:
+    virtual ~IDebugCanvas() = default;
+
+    virtual void DrawLabel(const char* text, Vector2 position, float fontSize, Color color) = 0;
+};
+
+enum class SearchEventKind : uint8_t {
+    START,          // the source node
+    DISCOVERED,     // first pushed onto the frontier
+    RELAXED,        // already discovered, reached again by a cheaper path
+    SETTLED,        // taken off the frontier and expanded
+    PATH,           // part of the final path, emitted by whoever runs the solver
+
+    // The search from the end node in bidirectional solvers.
+    BACKWARD_DISCOVERED,
+    BACKWARD_SETTLED
+};
+
+// Node is a dense CsrGraph index, not a Node id.
+struct SearchEvent {
+    int node;
+    SearchEventKind kind;
+};
+
+// Receives a solver's progress as it happens. Solvers never touch the Graph
+// they search; whoever shows the search (the GUI, a trace recorder) turns
+// events into colors on its own thread.
+class ISearchObserver {
+public:
+    virtual ~ISearchObserver() = default;
+
+    virtual void OnSearchEvent(SearchEvent event) = 0;
+};
+
 class ISolver {
+protected:
+    ISearchObserver* observer = nullptr;
+
+    void Emit(SearchEventKind kind, int u) {
+        if (observer) observer->OnSearchEvent({ u, kind });
+    }
+
+    // Whether the snapshot's connectivity index proves dense `end`
+    // unreachable from `start`. Solvers check it in Initialize and then treat
+    // the start as unknown, finishing with FINISHED_NO_PATH on the first Step
+    // instead of exhausting the start's component. -1 proves nothing.
+    static bool ProvablyUnreachable(const CsrGraph* graph, int start, int end) {
+        return start != -1 && end != -1 && !graph->MayReach(start, end);
+    }
+
 public:
     virtual ~ISolver() = default;
 
-    virtual void Initialize(Graph* graph, int startNodeID, int endNodeId) = 0;
+    // Events go to `observer` from the thread that calls Initialize/Step.
+    // nullptr (the default) runs silently.
+    void SetObserver(ISearchObserver* newObserver) { observer = newObserver; }
+
+    // Runs on the graph's current CSR snapshot.
+    void Initialize(Graph* graph, int startNodeID, int endNodeId) {
+        Initialize(&graph->GetSnapshot(), startNodeID, endNodeId);
+    }
+
+    // Runs on any frozen snapshot, including one attached to a memory-mapped
+    // graph file. Ids are Node ids, not dense indices.
+    virtual void Initialize(const CsrGraph* graph, int startNodeID, int endNodeId) = 0;
     virtual SolverState Step() = 0;
 
     virtual std::vector<int> GetPath() const = 0;
 
-    virtual void DrawDebug(Font font) = 0;
+    // Nodes taken off the frontier and expanded since Initialize.
+    virtual int GetExpandedCount() const = 0;
+
+    // Solvers that grow a shortest path tree from the start node copy it
+    // out here, for PathTreeCache; the rest return false. CanExportTree
+    // says which kind a solver is before it runs, so callers only look up
+    // cached trees for solvers that could have stored one.
+    virtual bool CanExportTree() const { return false; }
+    virtual bool ExportTree(ShortestPathTree& /*tree*/) const { return false; }
+
+    virtual void DrawDebug(IDebugCanvas& canvas) = 0;
 };
@@ -0,0 +1,81 @@
+#pragma once
+#include "../core/CsrGraph.hpp"
+#include <cstdint>
+#include <vector>
+
+// Landmark distance tables for the ALT heuristic (A*, Landmarks, Triangle
+// inequality; Goldberg & Harrelson).
+//
+// For every landmark L the table stores dist(L, u) and dist(u, L) for all
+// nodes. The triangle inequality then bounds the remaining distance from
+// below without looking at coordinates at all:
+//
+//     dist(u, t) >= dist(L, t) - dist(L, u)
+//     dist(u, t) >= dist(u, L) - dist(t, L)
+//
+// The bounds are tight when u and t line up behind a landmark, so landmarks
+// should sit on the periphery of the graph:
+//   FARTHEST picks each new landmark as far as possible from the ones
+//     chosen so far.
+//   AVOID (Goldberg & Werneck) grows a shortest path tree from a random
+//     root and descends into the subtree whose nodes the current landmarks
+//     bound worst, avoiding subtrees that already hold a landmark.
+//
+// Selection is sequential (each landmark depends on the previous ones); the
+// reverse-direction tables are then computed in parallel on a ThreadPool.
+// Rows are node-major, so one bound reads two short contiguous runs.
+enum class LandmarkStrategy {
+    FARTHEST,
+    AVOID
+};
+
+struct LandmarkOptions {
+    int count = 16;
+    LandmarkStrategy strategy = LandmarkStrategy::AVOID;
+    int threadCount = 0;      // 0 = one per hardware thread
+    uint32_t seed = 1;
+};
+
+class LandmarkTable {
+private:
+    int nodeCount = 0;
+    int landmarkCount = 0;
+    uint64_t sourceBuildId = 0;
+
+    std::vector<int> landmarks;
+    std::vector<float> fromLandmark;   // [u * landmarkCount + i] = dist(landmark i, u)
+    std::vector<float> toLandmark;     // [u * landmarkCount + i] = dist(u, landmark i)
+
+public:
+    void Build(const CsrGraph& graph, const LandmarkOptions& options = {});
+    void Clear();
+
+    bool Matches(const CsrGraph& graph) const {
+        return landmarkCount > 0 && sourceBuildId == graph.GetBuildId();
+    }
+
+    int GetLandmarkCount() const { return landmarkCount; }
+
+    // Dense indices of the chosen landmarks.
+    const std::vector<int>& GetLandmarks() const { return landmarks; }
+
+    // Best lower bound on dist(u, t) over all landmarks. Infinite when a
+    // landmark proves t unreachable from u.
+    float LowerBound(int u, int t) const {
+        const float* fromU = &fromLandmark[static_cast<size_t>(u) * landmarkCount];
+        const float* fromT = &fromLandmark[static_cast<size_t>(t) * landmarkCount];
+        const float* toU = &toLandmark[static_cast<size_t>(u) * landmarkCount];
+        const float* toT = &toLandmark[static_cast<size_t>(t) * landmarkCount];
+
+        // Unreachable entries are infinite: inf - inf is NaN, which never
+        // compares greater, and finite - inf is -inf; both drop out.
+        float best = 0.0f;
+        for (int i = 0; i < landmarkCount; ++i) {
+            float forward = fromT[i] - fromU[i];
+            float backward = toU[i] - toT[i];
+            if (forward > best) best = forward;
+            if (backward > best) best = backward;
+        }
+        return best;
+    }
+};
@@ -0,0 +1,102 @@
+#pragma once
+#include "../core/CsrGraph.hpp"
+#include "../core/ThreadPool.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Level-synchronous, direction-optimizing breadth-first search (Beamer,
+// Asanovic & Patterson) over a ThreadPool. Edge weights are ignored.
+//
+// Top-down levels expand the frontier's out-edges, claiming each newly seen
+// node with a compare-and-swap on its parent. Once the frontier's edges
+// outweigh the unexplored ones (by `alpha`), levels run bottom-up instead:
+// every unvisited node scans its in-edges (a reverse CSR) for any parent in
+// the frontier and stops at the first hit. That skips most edge checks in
+// the few huge middle levels of a low-diameter graph. Bottom-up levels read
+// the frontier as a bitmap and write the next one a 64-node word at a time,
+// so no two threads touch the same word. The search returns to top-down
+// when the frontier shrinks below 1/`beta` of the nodes.
+struct ParallelBfsOptions {
+    int threadCount = 0;    // 0 = one per hardware thread
+    int alpha = 15;         // top-down -> bottom-up when frontier edges > unexplored edges / alpha
+    int beta = 18;          // bottom-up -> top-down when frontier nodes < nodes / beta
+};
+
+class ParallelBfs {
+private:
+    struct Worker {
+        std::vector<int> next;
+        long long scout = 0;    // out-edges of the nodes in `next`
+    };
+
+    ParallelBfsOptions options;
+    ThreadPool pool;
+    std::vector<Worker> workers;
+
+    const CsrGraph* graph = nullptr;
+    CsrGraph reverse;
+    uint64_t reverseSourceId = 0;
+
+    int nodeCount = 0;
+    std::unique_ptr<std::atomic<int>[]> parent;    // -1 = unvisited; the source is its own parent
+    std::vector<int> depth;
+    int wordCount = 0;
+    std::unique_ptr<std::atomic<uint64_t>[]> frontierBits;
+    std::unique_ptr<std::atomic<uint64_t>[]> nextBits;
+
+    int target = -1;
+    int level = 0;
+    bool bottomUp = false;
+    bool finished = true;
+    bool exhausted = false;     // ran out of nodes rather than stopping at the target
+    int bottomUpLevels = 0;
+    long long scout = 0;
+    long long edgesToCheck = 0;
+    size_t previousFrontierSize = 0;
+    std::vector<int> frontier;
+
+    bool materialized = false;
+    std::vector<int> parents;
+
+    void TopDownLevel();
+    void BottomUpLevel();
+    void FillFrontierBits();
+    void GatherNext();
+
+public:
+    explicit ParallelBfs(const ParallelBfsOptions& options = {});
+
+    // Starts a search from dense index `source`. With a `target`, stops after
+    // the level that reaches it. `graph` must outlive the search.
+    void Begin(const CsrGraph& graph, int source, int target = -1);
+
+    // Expands one level. Returns false once the search is over.
+    bool Step();
+
+    // Begin plus Step until done.
+    void Run(const CsrGraph& graph, int source, int target = -1);
+
+    bool IsFinished() const { return finished; }
+    int GetLevelCount() const { return level; }
+    int GetBottomUpLevelCount() const { return bottomUpLevels; }
+
+    // True when the search ended by running out of nodes, so every depth is
+    // final. Otherwise the depths up to GetLevelCount() are.
+    bool IsExhausted() const { return exhausted; }
+
+    // Nodes first reached by the last Step (the source after Begin).
+    const std::vector<int>& GetFrontier() const { return frontier; }
+
+    // Live values; read them between Steps only. Parent is -1 for the
+    // source and unreached nodes.
+    int Depth(int u) const { return depth[u]; }
+    int Parent(int u) const;
+
+    // Hop count from the source per node (-1 if unreached).
+    const std::vector<int>& GetDepths() const { return depth; }
+
+    // Every node's parent, filled on first use after the search.
+    const std::vector<int>& GetParents();
+};
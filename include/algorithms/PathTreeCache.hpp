@@ -0,0 +1,77 @@
+#pragma once
+#include "../core/CsrGraph.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// What a single-source search left behind: distances and parents by CSR
+// index. A search that stopped early (at its end node) is still a valid tree
+// for every node no farther than the last distance it settled, so the tree
+// records that radius and only answers for nodes inside it.
+struct ShortestPathTree {
+    int root = -1;
+    std::vector<float> dist;     // infinity for nodes not reached
+    std::vector<int> parent;     // -1 at the root and unreached nodes
+    float settledRadius = 0.0f;  // infinity once the search ran out of nodes
+
+    bool Covers(int u) const { return u >= 0 && u < static_cast<int>(dist.size()) && dist[u] <= settledRadius; }
+};
+
+// LRU cache of shortest path trees keyed by (algorithm, source Node id,
+// graph version). A repeated query from a cached source then costs a walk
+// back along parents instead of a search. The version should change with
+// every edit: Graph::GetVersion(), or CsrGraph::GetBuildId() for a snapshot
+// with no Graph behind it. Trees of older versions are never hit again and
+// age out.
+class PathTreeCache {
+private:
+    struct Key {
+        std::string algorithm;
+        int source;
+        uint64_t version;
+
+        bool operator==(const Key& other) const {
+            return source == other.source && version == other.version && algorithm == other.algorithm;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        Key key;
+        ShortestPathTree tree;
+    };
+
+    size_t capacity;
+    std::list<Entry> entries;   // most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+
+    uint64_t hitCount = 0;
+    uint64_t missCount = 0;
+
+public:
+    explicit PathTreeCache(size_t capacity = 16) : capacity(capacity) {}
+
+    // The cached tree for the key if it covers dense index `target`,
+    // otherwise nullptr. Counts a hit or a miss.
+    const ShortestPathTree* Find(const std::string& algorithm, int source, uint64_t version, int target);
+
+    // Stores `tree` under the key, replacing any tree there, and evicts the
+    // least recently used tree when over capacity.
+    void Insert(const std::string& algorithm, int source, uint64_t version, ShortestPathTree&& tree);
+
+    void Clear();
+
+    size_t Size() const { return entries.size(); }
+    uint64_t GetHitCount() const { return hitCount; }
+    uint64_t GetMissCount() const { return missCount; }
+
+    // Node ids from the root to dense index `target`; empty if the tree does
+    // not reach it.
+    static std::vector<int> TracePath(const CsrGraph& graph, const ShortestPathTree& tree, int target);
+};
@@ -0,0 +1,111 @@
+#pragma once
+#include "ISolver.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Compact recording of one search, for replay and offline analysis.
+//
+// Each event is one LEB128 varint holding the zigzag-encoded difference to
+// the previous event's node and the event kind in the low 3 bits. Searches
+// mostly move between nearby indices, so typical events take 1-3 bytes.
+//
+// Every `keyframeInterval` events the recorder also stores a snapshot of
+// every node's mark, so a TracePlayer reaches any position by copying the
+// nearest earlier snapshot and decoding at most one interval of events.
+// The interval is at least the node count, which keeps the snapshots no
+// larger than one byte per recorded event.
+//
+// A node's mark is 0 if no event touched it yet, otherwise 1 + the kind of
+// the last event that did (RELAXED is stored as DISCOVERED).
+class SearchTrace : public ISearchObserver {
+private:
+    friend class TracePlayer;
+
+    struct Keyframe {
+        uint64_t byteOffset;
+        int32_t prevNode;
+        int32_t reserved;
+    };
+
+    int nodeCount = 0;
+    uint64_t eventCount = 0;
+    uint64_t keyframeInterval = MIN_KEYFRAME_INTERVAL;
+
+    std::vector<uint8_t> bytes;
+    std::vector<Keyframe> keyframes;
+    std::vector<uint8_t> snapshots;   // keyframes.size() * nodeCount marks
+
+    // Recorder state.
+    std::vector<uint8_t> marks;
+    int prevNode = 0;
+
+public:
+    static constexpr uint64_t MIN_KEYFRAME_INTERVAL = 4096;
+
+    // Starts an empty trace for a graph with `nodeCount` dense nodes.
+    void Begin(int nodeCount);
+    void Clear();
+
+    void OnSearchEvent(SearchEvent event) override;
+
+    int GetNodeCount() const { return nodeCount; }
+    uint64_t GetEventCount() const { return eventCount; }
+
+    // Encoded events plus snapshots, in bytes.
+    size_t GetByteSize() const { return bytes.size() + snapshots.size(); }
+
+    bool Save(const std::string& path, std::string* error = nullptr) const;
+    bool Load(const std::string& path, std::string* error = nullptr);
+};
+
+// Mark 0 means untouched; anything else is 1 + a SearchEventKind.
+inline SearchEventKind MarkToKind(uint8_t mark) {
+    return static_cast<SearchEventKind>(mark - 1);
+}
+
+// Seekable view of a SearchTrace. Moving forward decodes events from the
+// current position; moving backward (or far forward) restarts from the
+// closest keyframe at or before the target.
+class TracePlayer {
+private:
+    const SearchTrace* trace = nullptr;
+    std::vector<uint8_t> marks;
+    uint64_t position = 0;
+    uint64_t byteOffset = 0;
+    int prevNode = 0;
+
+    std::vector<int> changed;
+    bool fullRefresh = false;
+
+    void LoadKeyframe(uint64_t index);
+    void DecodeUntil(uint64_t target);
+
+public:
+    // Rewinds to position 0. The trace must outlive the player.
+    void Attach(const SearchTrace& trace);
+    void Detach();
+    bool IsAttached() const { return trace != nullptr; }
+
+    // Puts the marks at the state after the first `eventIndex` events
+    // (clamped to the trace length).
+    void Seek(uint64_t eventIndex);
+    void Skip(int64_t delta);
+
+    uint64_t GetPosition() const { return position; }
+    uint64_t GetLength() const { return trace ? trace->eventCount : 0; }
+    uint8_t GetMark(int u) const { return marks[u]; }
+
+    // Reports every node whose mark may have changed since the last call
+    // as fn(node, mark); after a keyframe jump that is every node.
+    template <typename Fn>
+    void ConsumeChanges(Fn&& fn) {
+        if (fullRefresh) {
+            for (int u = 0; u < static_cast<int>(marks.size()); ++u) fn(u, marks[u]);
+        } else {
+            for (int u : changed) fn(u, marks[u]);
+        }
+        changed.clear();
+        fullRefresh = false;
+    }
+};
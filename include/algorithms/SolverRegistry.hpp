@@ -0,0 +1,15 @@
+#pragma once
+#include "ISolver.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+// Name -> solver lookup for the headless tools ("bfs", "bfs-parallel",
+// "dfs", "dijkstra", "astar", "astar-alt" for A* on landmark bounds,
+// "radix" / "radix-quantized" for RadixDijkstraSolver, "bidijkstra" /
+// "biastar" for the bidirectional searches, "ch" for contraction
+// hierarchies, "delta" for delta-stepping, "lpastar" for Lifelong Planning
+// A*, plus "dijkstra-lazy" / "astar-lazy" on the lazy-deletion binary heap).
+// GetSolverNames lists them all. Returns nullptr for an unknown name.
+std::unique_ptr<ISolver> CreateSolver(const std::string& name);
+std::vector<std::string> GetSolverNames();
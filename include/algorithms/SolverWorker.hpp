@@ -0,0 +1,103 @@
+#pragma once
+#include "ISolver.hpp"
+#include "../core/SpscRing.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+// How far the worker may advance before parking again.
+struct StepQuota {
+    static constexpr long long UNLIMITED_STEPS = std::numeric_limits<long long>::max();
+    static constexpr float UNLIMITED_MS = std::numeric_limits<float>::infinity();
+
+    long long steps = 0;
+    float milliseconds = UNLIMITED_MS;
+};
+
+// Runs an ISolver on a dedicated thread. The owner (the render loop) hands
+// out StepQuotas with Grant() and drains the solver's events once per frame;
+// the worker pushes them through a lock-free SPSC ring and blocks when the
+// ring is full, so a slow consumer throttles the search instead of dropping
+// events.
+//
+// While a run is active the solver belongs to the worker. The owner may only
+// look at it through TryInspect(), and must Cancel() before editing the
+// graph, resetting colors or destroying the solver.
+class SolverWorker : private ISearchObserver {
+private:
+    static constexpr size_t EVENT_CAPACITY = 1 << 18;
+
+    SpscRing<SearchEvent> events{ EVENT_CAPACITY };
+
+    std::thread thread;
+
+    // Guards the command fields below; held only briefly.
+    std::mutex commandMutex;
+    std::condition_variable wake;
+    bool quit = false;
+    bool initPending = false;
+    bool quotaPending = false;
+    StepQuota pendingQuota;
+
+    // Held by the worker while it touches the solver.
+    std::mutex solverMutex;
+    ISolver* solver = nullptr;
+    const CsrGraph* csr = nullptr;
+    int startNodeId = -1;
+    int endNodeId = -1;
+
+    // Bumped by Start and Cancel; work tagged with an older run is dropped.
+    std::atomic<uint64_t> generation{ 0 };
+    std::atomic<bool> interrupted{ false };
+    std::atomic<SolverState> state{ SolverState::NOT_STARTED };
+    std::atomic<int> expandedCount{ 0 };
+
+    void OnSearchEvent(SearchEvent event) override;
+    void Run();
+    void RunQuota(const StepQuota& quota, uint64_t runGeneration);
+
+public:
+    SolverWorker();
+    ~SolverWorker();
+    SolverWorker(const SolverWorker&) = delete;
+    SolverWorker& operator=(const SolverWorker&) = delete;
+
+    // Cancels any previous run, then initializes `solver` on the worker
+    // thread. Nothing is stepped until the first Grant.
+    void Start(ISolver& solver, const CsrGraph& graph, int startNodeId, int endNodeId);
+
+    // Replaces the pending quota and wakes the worker.
+    void Grant(const StepQuota& quota);
+
+    // Ends the quota being run as soon as the current Step returns; the run
+    // resumes with the next Grant.
+    void Interrupt();
+
+    // Stops the run, waits for the worker to let go of the solver and
+    // discards undrained events. Afterwards the state is NOT_STARTED.
+    void Cancel();
+
+    // Hands every event published since the last call to `fn`, in order.
+    // Must be called from the owner's thread only.
+    template <typename Fn>
+    size_t Drain(Fn&& fn) {
+        return events.ConsumeAll(std::forward<Fn>(fn));
+    }
+
+    // Runs `fn` with the solver if the worker is parked right now; returns
+    // false without waiting otherwise.
+    template <typename Fn>
+    bool TryInspect(Fn&& fn) {
+        std::unique_lock<std::mutex> lock(solverMutex, std::try_to_lock);
+        if (!lock.owns_lock() || !solver) return false;
+        fn(*solver);
+        return true;
+    }
+
+    // Once this reports a finished state, every event of the run (including
+    // the PATH events) is already in the ring.
+    SolverState GetState() const { return state.load(std::memory_order_acquire); }
+    int GetExpandedCount() const { return expandedCount.load(std::memory_order_relaxed); }
+};
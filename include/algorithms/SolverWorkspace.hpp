@@ -0,0 +1,110 @@
+#pragma once
+#include "../core/DaryHeap.hpp"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Per-node search state that a new query resets in O(1). Every node record
+// carries the epoch it was last written in, and a record from an older epoch
+// reads as unreached (infinite distance and score, no parent). Begin only
+// bumps the epoch, so a short search on a big graph costs what it touches
+// instead of a pass over every node.
+//
+// A node's stamp, distance, score and parent share one 16-byte record, so a
+// relaxation touches a single cache line. The arrays only ever grow; the same
+// workspace serves graphs of any size up to the largest it has seen.
+class SolverWorkspace {
+public:
+    struct NodeState {
+        uint32_t stamp;
+        float dist;
+        float score;    // A*'s f, free for other per-node keys
+        int parent;
+    };
+
+private:
+    std::vector<NodeState> nodes;
+    uint32_t epoch = 0;
+
+    IndexedDaryHeap<float> heap;
+    std::vector<int> reached;
+    std::vector<int> stack;
+
+public:
+    // Starts a query on a graph of `nodeCount` nodes: every node reads as
+    // unreached and the heap and lists are empty.
+    void Begin(int nodeCount);
+
+    // Whether `u` was written since Begin.
+    bool Contains(int u) const { return nodes[u].stamp == epoch; }
+
+    float Distance(int u) const;
+    float Score(int u) const;
+    int Parent(int u) const { return Contains(u) ? nodes[u].parent : -1; }
+
+    // The record of `u` for this query, reset to unreached on first use.
+    NodeState& Touch(int u) {
+        NodeState& node = nodes[u];
+        if (node.stamp != epoch) node = Unreached();
+        return node;
+    }
+
+    NodeState Unreached() const;
+
+    // Scratch shared by the solvers: the queue, nodes in discovery order
+    // (BFS's FIFO, the DrawDebug lists) and a DFS stack.
+    IndexedDaryHeap<float>& Heap() { return heap; }
+    std::vector<int>& Reached() { return reached; }
+    const std::vector<int>& Reached() const { return reached; }
+    std::vector<int>& Stack() { return stack; }
+
+    size_t GetCapacity() const { return nodes.size(); }
+};
+
+// Hands SolverWorkspaces out and takes them back, so the solver created for
+// the next query (or the next algorithm picked in the app) starts with arrays
+// already sized for the graph. Thread-safe.
+class SolverWorkspacePool {
+public:
+    // Holds a workspace until destroyed, then gives it back to the pool.
+    class Lease {
+    private:
+        SolverWorkspacePool* pool = nullptr;
+        std::unique_ptr<SolverWorkspace> workspace;
+
+        friend class SolverWorkspacePool;
+        void Return();
+
+    public:
+        Lease() = default;
+        ~Lease() { Return(); }
+        Lease(Lease&& other) noexcept = default;
+        Lease& operator=(Lease&& other) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        explicit operator bool() const { return workspace != nullptr; }
+        SolverWorkspace* operator->() const { return workspace.get(); }
+        SolverWorkspace& operator*() const { return *workspace; }
+    };
+
+private:
+    std::mutex mutex;
+    std::vector<std::unique_ptr<SolverWorkspace>> idle;   // most recently returned last
+
+public:
+    SolverWorkspacePool() = default;
+    SolverWorkspacePool(const SolverWorkspacePool&) = delete;
+    SolverWorkspacePool& operator=(const SolverWorkspacePool&) = delete;
+
+    // The most recently returned workspace (the likeliest to fit and to be
+    // in cache), or a new one if none is idle.
+    Lease Acquire();
+
+    size_t GetIdleCount();
+
+    // The pool the solvers borrow from. Leases must end before the program
+    // does, i.e. solvers must not be static.
+    static SolverWorkspacePool& Shared();
+};
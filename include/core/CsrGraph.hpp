@@ -0,0 +1,156 @@
+#pragma once
+#include "Types.hpp"
+#include <cstdint>
+#include <vector>
+
+class Graph;
+
+// One edge edit between two snapshots of a Graph, by Node id. A new edge has
+// an infinite oldWeight.
+struct EdgeChange {
+    int fromId;
+    int toId;
+    float oldWeight;
+    float newWeight;
+};
+
+// Frozen compressed-sparse-row copy of a Graph's topology.
+// Nodes are renumbered to dense indices 0..N-1 (in ascending node id order),
+// so solvers can index plain arrays instead of hashing into the Graph's maps.
+// The outgoing edges of dense node u are the range [EdgesBegin(u), EdgesEnd(u)).
+//
+// The arrays are either owned (Build) or borrowed from memory someone else
+// keeps alive (Attach), e.g. a memory-mapped graph file. Accessors read the
+// same way in both cases.
+class CsrGraph {
+private:
+    int nodeCount = 0;
+    int edgeCount = 0;
+    int denseIndexSize = 0;
+    uint64_t buildId = 0;
+
+    const int* offsets = nullptr;
+    const int* targets = nullptr;
+    const float* weights = nullptr;
+    const int* nodeIds = nullptr;
+    const int* denseIndex = nullptr;
+    const Vector2* positions = nullptr;
+
+    std::vector<int> ownedOffsets;
+    std::vector<int> ownedTargets;
+    std::vector<float> ownedWeights;
+    std::vector<int> ownedNodeIds;
+    std::vector<int> ownedDenseIndex;
+    std::vector<Vector2> ownedPositions;
+
+    // Only set when built from a Graph; attached snapshots have none.
+    Graph* source = nullptr;
+
+    // The snapshot this one replaced and the edge edits made in between;
+    // see SetHistory.
+    uint64_t previousBuildId = 0;
+    std::vector<EdgeChange> edgeChanges;
+
+    // Per dense node: weakly connected component, and strongly connected
+    // component numbered so that no edge leads to a higher number. Empty
+    // when unknown; sccIds also when every edge has its reverse, since the
+    // components then say it all.
+    std::vector<int> componentIds;
+    std::vector<int> sccIds;
+
+    void BuildSccs();
+
+public:
+    CsrGraph() = default;
+    CsrGraph(const CsrGraph&) = delete;
+    CsrGraph& operator=(const CsrGraph&) = delete;
+    CsrGraph(CsrGraph&&) = default;
+    CsrGraph& operator=(CsrGraph&&) = default;
+
+    // Also takes the graph's weakly connected components, and works out the
+    // strongly connected ones if it has one-way edges (see MayReach).
+    void Build(Graph& graph);
+
+    // Same nodes and dense indices as `forward`, every edge flipped: the
+    // edges of u are the edges *into* u in `forward`. Node ids and positions
+    // are borrowed from `forward`, which must outlive this snapshot.
+    void BuildReverse(const CsrGraph& forward);
+
+    // Borrows the arrays; `offsets` has nodeCount + 1 entries and
+    // `denseIndex` maps node ids in [0, denseIndexSize) to a dense index or -1.
+    void Attach(int nodeCount, int edgeCount,
+                const int* offsets, const int* targets, const float* weights,
+                const int* nodeIds, const int* denseIndex, int denseIndexSize,
+                const Vector2* positions);
+
+    void Clear();
+
+    // Process-wide unique per Build/Attach/Clear. Per-graph caches (prepared
+    // weights, indices) key on it: a rebuilt snapshot at the same address
+    // still gets a new id.
+    uint64_t GetBuildId() const { return buildId; }
+
+    // Records that this snapshot is the build `previousBuildId` plus
+    // `changes`, with nodes only ever appended (existing dense indices stay
+    // put). Graph::GetSnapshot sets it when it knows every edit in between;
+    // incremental solvers that saw the previous build repair their state
+    // from the changes instead of starting over. Reset by Build/Attach/Clear.
+    void SetHistory(uint64_t previousBuildId, std::vector<EdgeChange>&& changes);
+
+    // Computes the connectivity index from the edges alone, for snapshots
+    // that did not get one from Build: attached ones and reverse ones.
+    // O(nodes + edges).
+    void BuildConnectivity();
+
+    bool HasConnectivity() const { return !componentIds.empty(); }
+
+    // False only when no path from dense u to dense v can exist: different
+    // components, or strongly connected components in an order that no path
+    // climbs. True means there may be one (there is, within one SCC, or
+    // within one component of a graph without one-way edges). O(1).
+    bool MayReach(int u, int v) const {
+        if (componentIds.empty()) return true;
+        if (componentIds[u] != componentIds[v]) return false;
+        return sccIds.empty() || sccIds[u] >= sccIds[v];
+    }
+
+    // 0 when the history is unknown.
+    uint64_t GetPreviousBuildId() const { return previousBuildId; }
+    const std::vector<EdgeChange>& GetEdgeChanges() const { return edgeChanges; }
+
+    int NodeCount() const { return nodeCount; }
+    int EdgeCount() const { return edgeCount; }
+
+    int EdgesBegin(int u) const { return offsets[u]; }
+    int EdgesEnd(int u) const { return offsets[u + 1]; }
+    int Target(int e) const { return targets[e]; }
+    float Weight(int e) const { return weights[e]; }
+
+    // Node id -> dense index, or -1 if the id is not part of the snapshot.
+    int ToDense(int nodeId) const {
+        if (nodeId < 0 || nodeId >= denseIndexSize) return -1;
+        return denseIndex[nodeId];
+    }
+    int ToNodeId(int u) const { return nodeIds[u]; }
+    int MaxNodeId() const { return denseIndexSize - 1; }
+
+    Vector2 Position(int u) const { return positions[u]; }
+
+    // out[i] = straight-line distance from dense node nodes[i] to `to`, the
+    // same value as Distance(Position(nodes[i]), to). Positions are gathered
+    // into a small buffer first so the arithmetic vectorizes; this is what
+    // A* uses to score all the neighbours of a node at once.
+    void DistancesTo(const int* nodes, int count, Vector2 to, float* out) const;
+
+    // Raw arrays, for serialization.
+    const int* OffsetsData() const { return offsets; }
+    const int* TargetsData() const { return targets; }
+    const float* WeightsData() const { return weights; }
+    const int* NodeIdsData() const { return nodeIds; }
+    const int* DenseIndexData() const { return denseIndex; }
+    const Vector2* PositionsData() const { return positions; }
+
+    // Solver visualization: recolors the node in the Graph the snapshot was
+    // built from, if there is one.
+    void SetColor(int u, Color color) const;
+};
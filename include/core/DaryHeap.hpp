@@ -0,0 +1,151 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Addressable min-heap over dense node indices 0..N-1 with a real
+// decrease-key: every node is in the heap at most once, so there are no
+// stale entries to skip, and the heap never grows past the frontier size.
+//
+// Entries keep their key next to the node so sift loops compare within one
+// cache line; `position` maps a node to its slot (-1 when absent). Arity D
+// trades a shallower tree (fewer cache misses on decrease-key) against more
+// comparisons per pop; 4 is the usual sweet spot for graph searches.
+template <typename Key, int D = 4>
+class IndexedDaryHeap {
+private:
+    struct Entry {
+        Key key;
+        int node;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<int> position;
+
+    void Place(size_t slot, const Entry& entry) {
+        entries[slot] = entry;
+        position[entry.node] = static_cast<int>(slot);
+    }
+
+    void SiftUp(size_t slot) {
+        Entry moving = entries[slot];
+        while (slot > 0) {
+            size_t parent = (slot - 1) / D;
+            if (!(moving.key < entries[parent].key)) break;
+            Place(slot, entries[parent]);
+            slot = parent;
+        }
+        Place(slot, moving);
+    }
+
+    void SiftDown(size_t slot) {
+        Entry moving = entries[slot];
+        const size_t count = entries.size();
+        for (;;) {
+            size_t first = slot * D + 1;
+            if (first >= count) break;
+
+            size_t last = first + D < count ? first + D : count;
+            size_t best = first;
+            for (size_t child = first + 1; child < last; ++child) {
+                if (entries[child].key < entries[best].key) best = child;
+            }
+            if (!(entries[best].key < moving.key)) break;
+
+            Place(slot, entries[best]);
+            slot = best;
+        }
+        Place(slot, moving);
+    }
+
+public:
+    // Sizes the index for nodes 0..nodeCount-1 and empties the heap. Only
+    // nodes still queued are touched when the size does not change.
+    void Reset(int nodeCount) {
+        if (position.size() != static_cast<size_t>(nodeCount)) {
+            position.assign(nodeCount, -1);
+        } else {
+            for (const Entry& entry : entries) position[entry.node] = -1;
+        }
+        entries.clear();
+    }
+
+    // Extends the index to nodes 0..nodeCount-1, keeping what is queued.
+    void Grow(int nodeCount) {
+        if (position.size() < static_cast<size_t>(nodeCount)) position.resize(nodeCount, -1);
+    }
+
+    bool Empty() const { return entries.empty(); }
+    size_t Size() const { return entries.size(); }
+    bool Contains(int node) const { return position[node] != -1; }
+
+    int TopNode() const { return entries.front().node; }
+    Key TopKey() const { return entries.front().key; }
+
+    // Inserts `node`, or lowers its key if it is queued with a larger one.
+    // Returns false (and changes nothing) if the queued key is not larger.
+    bool PushOrDecrease(int node, Key key) {
+        int slot = position[node];
+        if (slot == -1) {
+            entries.push_back({ key, node });
+            SiftUp(entries.size() - 1);
+            return true;
+        }
+        if (!(key < entries[slot].key)) return false;
+        entries[slot].key = key;
+        SiftUp(slot);
+        return true;
+    }
+
+    // Inserts `node` or moves it to `key`, whichever way that goes.
+    void PushOrUpdate(int node, Key key) {
+        int slot = position[node];
+        if (slot == -1) {
+            entries.push_back({ key, node });
+            SiftUp(entries.size() - 1);
+            return;
+        }
+        bool lower = key < entries[slot].key;
+        entries[slot].key = key;
+        if (lower) SiftUp(slot);
+        else SiftDown(slot);
+    }
+
+    // Takes `node` out if it is queued.
+    void Remove(int node) {
+        int slot = position[node];
+        if (slot == -1) return;
+        position[node] = -1;
+
+        Entry last = entries.back();
+        entries.pop_back();
+        if (static_cast<size_t>(slot) == entries.size()) return;
+
+        entries[slot] = last;
+        position[last.node] = slot;
+        if (slot > 0 && last.key < entries[(slot - 1) / D].key) SiftUp(slot);
+        else SiftDown(slot);
+    }
+
+    // Recomputes every queued key with keyOf(node) and restores heap order
+    // bottom-up, for when the keys change all at once.
+    template <typename KeyOf>
+    void Rekey(KeyOf&& keyOf) {
+        for (Entry& entry : entries) entry.key = keyOf(entry.node);
+        for (size_t slot = entries.size() / D + 1; slot-- > 0;) {
+            if (slot < entries.size()) SiftDown(slot);
+        }
+    }
+
+    int Pop() {
+        int node = entries.front().node;
+        position[node] = -1;
+
+        Entry last = entries.back();
+        entries.pop_back();
+        if (!entries.empty()) {
+            entries[0] = last;
+            SiftDown(0);
+        }
+        return node;
+    }
+};
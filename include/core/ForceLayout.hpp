@@ -0,0 +1,129 @@
+#pragma once
+#include "CsrGraph.hpp"
+#include "ThreadPool.hpp"
+#include "Types.hpp"
+#include <cstdint>
+#include <vector>
+
+class Graph;
+
+// Multilevel spring-electrical layout (Hu; Walshaw) for graphs that come
+// without usable coordinates.
+//
+// Every node repels every other one with C K^2 / d and edges pull their ends
+// together with d^2 / K, so K sets the scale of the layout.
+// Repulsion is approximated with a Barnes-Hut quadtree: a cell far enough
+// away (its side over the distance below theta) acts as a single body at its
+// center of mass, which makes an iteration O(N log N) instead of O(N^2). The
+// tree is rebuilt each iteration from the nodes sorted by Morton code, and
+// forces are computed in that order on a ThreadPool, so neighbouring threads
+// walk neighbouring cells.
+//
+// Laid out in one go, a large graph folds over itself. So the graph is first
+// coarsened by repeatedly merging matched pairs of neighbours; the coarsest
+// graph is laid out from its nodes' average positions, and each finer level
+// starts from where its coarse nodes ended up. Only the finest level needs
+// many small moves.
+//
+// Each iteration moves every node by the current step length along its
+// force. The step grows after five iterations in a row that lowered the
+// total energy and shrinks after any that did not; a level has converged
+// once it is below tolerance * K. Edge directions and weights are ignored.
+struct ForceLayoutOptions {
+    float edgeLength = 120.0f;  // K on the finest level
+    float theta = 0.8f;         // 0 computes every pair exactly
+    float gravity = 0.01f;      // pull toward the centroid, keeps components together
+    float tolerance = 0.1f;
+    int maxIterations = 500;    // per level
+    int threadCount = 0;        // 0 = one per hardware thread
+};
+
+class ForceLayout {
+private:
+    struct Cell {
+        float x, y;         // center of mass
+        float mass;         // nodes below
+        float size;         // side of the square
+        int begin, end;     // range in Morton order
+        int firstChild;     // children are contiguous; -1 for a leaf
+        int childCount;
+    };
+
+    struct Level {
+        // Undirected, deduplicated neighbour lists.
+        std::vector<int> offsets;
+        std::vector<int> neighbors;
+        std::vector<Vector2> positions;
+        std::vector<int> coarse;    // node of the next coarser level; empty on the coarsest
+        float edgeLength = 0.0f;
+
+        int NodeCount() const { return static_cast<int>(offsets.size()) - 1; }
+    };
+
+    ForceLayoutOptions options;
+    ThreadPool pool;
+
+    std::vector<int> nodeIds;
+    std::vector<Level> levels;      // finest first
+    int level = 0;                  // the one being laid out
+
+    // Rebuilt every iteration: nodes in Morton order and the tree over them.
+    std::vector<uint64_t> keys;
+    std::vector<uint64_t> sortBuffer;
+    std::vector<int> order;
+    std::vector<int> rank;
+    std::vector<Vector2> sorted;
+    std::vector<uint32_t> codes;
+    std::vector<Cell> cells;
+    std::vector<double> workerEnergy;
+    Vector2 boxOrigin = { 0.0f, 0.0f };
+    float boxSize = 0.0f;
+
+    float step = 0.0f;
+    double lastEnergy = 0.0;
+    int progress = 0;
+    int levelIteration = 0;
+    int iteration = 0;
+    bool finished = true;
+
+    std::vector<Vector2> projected;
+
+    void Compact(Level& target, std::vector<int>& fill);
+    bool Coarsen();
+    void StartLevel(int index);
+    void SortNodes(const std::vector<Vector2>& positions);
+    void BuildCell(int index, int begin, int end, int depth, Vector2 origin, float size);
+    Vector2 Repulsion(int i, float strength) const;
+
+public:
+    explicit ForceLayout(const ForceLayoutOptions& options = {});
+
+    // Takes the nodes, their current positions and the edges of `graph`,
+    // which need not outlive the layout, and builds the coarser levels.
+    void Begin(const CsrGraph& graph);
+
+    // One iteration on the current level, moving to the next finer one once
+    // it converges or hits maxIterations. Returns false once the finest
+    // level is done.
+    bool Step();
+
+    // Iterations until done or `budgetMs` has passed, at least one, so a
+    // frame can advance the layout without stalling. Returns false once done.
+    bool RunFor(float budgetMs);
+
+    // Begin plus Step until done; returns the iteration count.
+    int Run(const CsrGraph& graph);
+
+    // Moves the graph's nodes to the current positions.
+    void Apply(Graph& graph);
+
+    bool IsFinished() const { return finished; }
+    int GetIteration() const { return iteration; }
+    int GetLevelCount() const { return static_cast<int>(levels.size()); }
+    int GetLevel() const { return level; }
+    float GetStepLength() const { return step; }
+
+    // Positions by dense index of the graph given to Begin. While a coarser
+    // level is being laid out, every node sits at its coarse node.
+    const std::vector<Vector2>& GetPositions();
+};
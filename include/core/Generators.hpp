@@ -0,0 +1,19 @@
+#pragma once
+#include "Graph.hpp"
+#include <cstdint>
+
+// Deterministic synthetic graphs for benchmarks. The same arguments and seed
+// produce the same graph on every platform (no <random> distributions).
+// Edge weights are the Euclidean distance between the endpoints, the same way
+// main.cpp weights edges drawn with the mouse. All edges are bidirectional.
+
+// width x height lattice with 4-neighborhood, `spacing` apart.
+void GenerateGrid(Graph& graph, int width, int height, float spacing = 60.0f);
+
+// Points uniform in a square, connected to every other point within the
+// radius that gives the requested average degree.
+void GenerateRandomGeometric(Graph& graph, int nodeCount, float averageDegree, uint32_t seed);
+
+// Barabasi-Albert preferential attachment: every new node links to
+// `edgesPerNode` existing nodes chosen proportionally to their degree.
+void GenerateScaleFree(Graph& graph, int nodeCount, int edgesPerNode, uint32_t seed);
@@ -1,52 +1,120 @@
 #pragma once
-#include "raylib.h"
+#include "Types.hpp"
+#include "CsrGraph.hpp"
+#include "NodeStore.hpp"
+#include "SpatialGrid.hpp"
+#include <cstdint>
 #include <vector>
 #include <unordered_map>
 #include <string>
 #include <optional>
 
 constexpr float NODE_RADIUS = 20.0f;
-constexpr Color COLOR_DEFAULT = DARKBLUE;
-constexpr Color COLOR_HIGHLIGHT = RED;
+constexpr Color COLOR_DEFAULT = { 0, 82, 172, 255 };     // DARKBLUE
+constexpr Color COLOR_HIGHLIGHT = { 230, 41, 55, 255 };  // RED
+constexpr Color COLOR_START = { 255, 161, 0, 255 };      // ORANGE
+constexpr Color COLOR_FRONTIER = { 253, 249, 0, 255 };   // YELLOW
+constexpr Color COLOR_VISITED = { 230, 41, 55, 255 };    // RED
+constexpr Color COLOR_PATH = { 0, 228, 48, 255 };        // GREEN
+constexpr Color COLOR_BACKWARD_FRONTIER = { 102, 191, 255, 255 };  // SKYBLUE
+constexpr Color COLOR_BACKWARD_VISITED = { 135, 60, 190, 255 };    // VIOLET
+constexpr Color COLOR_TEXT = { 0, 0, 0, 255 };           // BLACK
+constexpr Color COLOR_TEXT_DIM = { 80, 80, 80, 255 };    // DARKGRAY
 
 struct Edge {
     int targetNodeId;
     float weight;
 };
 
-struct Node {
-    int id;
-    Vector2 position;
-    std::string label;
-    Color color;
-
-    void ResetVisuals() {
-        color = COLOR_DEFAULT;
-    }
-};
-
 class Graph {
 private:
-    std::unordered_map<int, Node> nodes;
+    NodeStore nodes;
     std::unordered_map<int, std::vector<Edge>> adjacencyList;
 
     int nextId = 0;
 
+    uint64_t version = 0;
+    uint64_t snapshotVersion = UINT64_MAX;
+    CsrGraph snapshot;
+
+    // Edge edits since the snapshot was last built, handed to the next one.
+    // Bulk construction would only fill it for nothing, so past
+    // MAX_PENDING_CHANGES it is dropped and the next snapshot has no history.
+    std::vector<EdgeChange> pendingChanges;
+    bool changesLost = false;
+
+    void RecordChange(int fromId, int toId, float oldWeight, float newWeight);
+
+    // Union-find over Node ids (which run 0..nextId-1), kept current by
+    // AddEgde: two nodes share a root iff an undirected path joins them.
+    std::vector<int> componentParent;
+    std::vector<int> componentSize;
+    int componentCount = 0;
+    size_t oneWayEdgeCount = 0;
+
+    void UniteComponents(int a, int b);
+
+    SpatialGrid spatialIndex{ 2.0f * NODE_RADIUS };
+
+    friend class CsrGraph;
+
 public:
     Graph() = default;
 
+    // Pre-sizes the node and adjacency tables for bulk construction.
+    void Reserve(size_t nodeCount);
+
     int AddNode(Vector2 position);
     void AddEgde(int fromId, int toId, float weight = 1.0f, bool biDirection = true);
 
+    // Sets the weight of every fromId -> toId edge (and toId -> fromId ones
+    // with biDirection). Returns false if there is no such edge.
+    bool SetEdgeWeight(int fromId, int toId, float weight, bool biDirection = true);
+    void SetNodePosition(int id, Vector2 position);
+
+    // Moves many nodes at once (positions[i] for ids[i]): the spatial index
+    // is rebuilt and the version bumped once instead of per node.
+    void SetNodePositions(const std::vector<int>& ids, const std::vector<Vector2>& positions);
+
+    // Visual only: neither bumps the version.
+    void SetNodeColor(int id, Color color);
+    void SetNodeLabel(int id, const std::string& label);
+
     void ResetGraphVisuals();
     void ClearAll();
 
-    Node* GetNode(int id);
+    bool HasNode(int id) const { return nodes.Contains(id); }
+    Vector2 GetNodePosition(int id) const { return nodes.Position(id); }
+    Color GetNodeColor(int id) const { return nodes.GetColor(id); }
+    std::string GetNodeLabel(int id) const { return nodes.Label(id); }
 
     const std::vector<Edge>& GetNeighbors(int id) const;
     std::vector<int> GetAllNodeIds() const;
+    const NodeStore& GetNodes() const { return nodes; }
+    size_t GetNodeCount() const { return nodes.Size(); }
+
+    // Weakly connected components (edge directions ignored), maintained as
+    // edges are added. Nodes in different ones can never reach each other.
+    int FindComponent(int id);
+    bool SameComponent(int a, int b) { return FindComponent(a) == FindComponent(b); }
+    int GetComponentCount() const { return componentCount; }
+
+    // Edges added with biDirection = false. Without any, components are
+    // also exactly the sets of mutually reachable nodes.
+    size_t GetOneWayEdgeCount() const { return oneWayEdgeCount; }
+
+    // Bumped by every topology change; used to invalidate the CSR snapshot.
+    uint64_t GetVersion() const { return version; }
 
-    void Draw(Font font);
+    // Returns the CSR view of the current topology, rebuilding it if the graph
+    // changed since the last call. A rebuilt snapshot carries the edge edits
+    // since the previous one (CsrGraph::SetHistory) unless ClearAll ran or
+    // there were too many to keep.
+    const CsrGraph& GetSnapshot();
 
+    // Spatial queries, answered by a uniform grid that AddNode keeps current.
     int GetNodeAtPosition(Vector2 pos) const;
+    int GetNearestNode(Vector2 pos) const;
+    std::vector<int> GetNodesInRect(Vector2 min, Vector2 max) const;
+    std::vector<int> GetNodesInRadius(Vector2 center, float radius) const;
 };
@@ -0,0 +1,103 @@
+#pragma once
+#include "Graph.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Versioned binary graph snapshot (.tgv).
+//
+// The file is a header, a section table and 64-byte aligned sections holding
+// the CSR arrays exactly as CsrGraph reads them, so a MappedGraphFile can
+// mmap it and hand out a CsrGraph that points straight into the mapping: no
+// parsing, no copying, pages fault in as the solvers touch them.
+//
+// Values are stored in native byte order; the header records it and Open
+// rejects files written on a machine with the other endianness.
+
+constexpr char GRAPH_FILE_MAGIC[8] = { 'T', 'G', 'V', 'G', 'R', 'A', 'P', 'H' };
+constexpr uint32_t GRAPH_FILE_VERSION = 1;
+constexpr uint32_t GRAPH_FILE_BYTE_ORDER = 0x01020304;
+
+enum GraphFileSectionTag : uint32_t {
+    SECTION_NODE_IDS = 1,       // int32[nodeCount], ascending
+    SECTION_DENSE_INDEX,        // int32[denseIndexSize], Node id -> dense index or -1
+    SECTION_POSITIONS,          // Vector2[nodeCount]
+    SECTION_OFFSETS,            // int32[nodeCount + 1]
+    SECTION_TARGETS,            // int32[edgeCount], dense indices
+    SECTION_WEIGHTS,            // float[edgeCount]
+    SECTION_LABEL_OFFSETS,      // uint64[nodeCount + 1] into SECTION_LABEL_BYTES
+    SECTION_LABEL_BYTES,        // concatenated labels, no terminators
+    SECTION_EXTERNAL_IDS,       // optional int64[nodeCount], ids from the imported file
+
+    // Precomputed indices (contraction hierarchies, landmark tables, ...)
+    // are stored as extra sections tagged from here up.
+    SECTION_USER_BASE = 0x100
+};
+
+struct GraphFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t nodeCount;
+    uint64_t edgeCount;
+    uint64_t denseIndexSize;
+    uint32_t sectionCount;
+    uint32_t reserved;
+};
+
+struct GraphFileSection {
+    uint32_t tag;
+    uint32_t reserved;
+    uint64_t offset;
+    uint64_t size;
+};
+
+// An extra section to append when saving.
+struct GraphFileBlob {
+    uint32_t tag;
+    const void* data;
+    uint64_t size;
+};
+
+bool SaveGraphFile(const std::string& path, Graph& graph,
+                   const std::vector<GraphFileBlob>& extras = {}, std::string* error = nullptr);
+
+// Replaces the contents of `graph` with the file's nodes and edges, for
+// editing in the app. Nodes get fresh sequential ids in file order, which
+// match the saved ids whenever those were 0..N-1. Pairs of opposite edges
+// with equal weights come back as two-way edges.
+bool LoadGraphFile(const std::string& path, Graph& graph, std::string* error = nullptr);
+
+// Read-only view of a graph file, mapped into memory.
+class MappedGraphFile {
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+    std::vector<char> fallback;
+
+    const GraphFileHeader* header = nullptr;
+    const GraphFileSection* sections = nullptr;
+    const uint64_t* labelOffsets = nullptr;
+    const char* labelBytes = nullptr;
+
+    CsrGraph csr;
+
+public:
+    MappedGraphFile() = default;
+    ~MappedGraphFile();
+    MappedGraphFile(const MappedGraphFile&) = delete;
+    MappedGraphFile& operator=(const MappedGraphFile&) = delete;
+
+    bool Open(const std::string& path, std::string* error = nullptr);
+    void Close();
+    bool IsOpen() const { return header != nullptr; }
+
+    // Valid until Close(); its arrays point into the mapping.
+    const CsrGraph& GetCsr() const { return csr; }
+
+    std::string_view GetLabel(int u) const;
+
+    // Extra section by tag, or nullptr.
+    const void* FindSection(uint32_t tag, uint64_t* sectionSize = nullptr) const;
+};
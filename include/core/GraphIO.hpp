@@ -0,0 +1,12 @@
+#pragma once
+#include "Graph.hpp"
+#include <string>
+
+// Plain text graph format, one record per line ('#' starts a comment):
+//
+//   n <x> <y>                      node; ids are assigned 0, 1, 2... in file order
+//   e <from> <to> [weight] [d]     edge; weight defaults to the Euclidean distance
+//                                  between the endpoints, 'd' makes it one-way
+//
+// Returns false and fills `error` (if given) on the first malformed line.
+bool LoadGraphText(const std::string& path, Graph& graph, std::string* error = nullptr);
@@ -0,0 +1,74 @@
+#pragma once
+#include "Graph.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class ImportFormat {
+    Auto,               // pick from the file extension
+    DimacsGraph,        // .gr:  "p sp <n> <m>", "a <from> <to> <weight>"
+    DimacsCoordinates,  // .co:  "v <id> <x> <y>"
+    EdgeList,           // .csv/.edges/.el: "<from>,<to>[,<weight>]"
+    NodeCoordinates     // .nodes/.xy: "<id>,<x>,<y>"
+};
+
+struct ImportOptions {
+    // Edge lists only; DIMACS arcs are always one-way.
+    bool directed = false;
+
+    // Applied to imported coordinates. Road-network files store degrees * 1e6
+    // with latitude growing north, so flipY keeps north at the top.
+    float coordinateScale = 1.0f;
+    bool flipY = false;
+};
+
+struct ImportStats {
+    size_t lines = 0;
+    size_t nodesCreated = 0;
+    size_t edgesAdded = 0;
+    size_t positionsSet = 0;
+};
+
+// Streaming loader for large external graphs. Files are read in fixed-size
+// chunks and parsed in place with std::from_chars, so memory stays flat no
+// matter how large the file is, and each record goes straight into the Graph.
+//
+// External node ids are remembered across Import calls, so a DIMACS .gr and
+// its .co (in either order), or an edge list and a coordinate file, describe
+// the same nodes. Nodes that never get coordinates are placed on a
+// deterministic spiral so the graph is still drawable.
+class GraphImporter {
+private:
+    Graph& graph;
+    ImportOptions options;
+    ImportStats stats;
+
+    // Small non-negative ids (DIMACS is 1..n) use a flat table; anything
+    // else falls back to a hash map.
+    std::vector<int> denseIds;
+    std::unordered_map<long long, int> sparseIds;
+    std::vector<long long> externalIds;
+
+    int ResolveNode(long long externalId);
+    Vector2 ScalePosition(double x, double y) const;
+
+    bool ImportDimacsGraph(const std::string& path, std::string* error);
+    bool ImportCoordinates(const std::string& path, bool dimacs, std::string* error);
+    bool ImportEdgeList(const std::string& path, std::string* error);
+
+public:
+    explicit GraphImporter(Graph& graph, ImportOptions options = {});
+
+    bool Import(const std::string& path, ImportFormat format = ImportFormat::Auto, std::string* error = nullptr);
+
+    const ImportStats& GetStats() const { return stats; }
+
+    // Graph id for an external id seen so far, or -1.
+    int FindNode(long long externalId) const;
+
+    // External id a Graph node was imported as, or the node id itself for
+    // nodes this importer did not create.
+    long long ToExternalId(int nodeId) const;
+};
+
+ImportFormat DetectImportFormat(const std::string& path);
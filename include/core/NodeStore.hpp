@@ -0,0 +1,56 @@
+#pragma once
+#include "Types.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Per-node data of a Graph as parallel arrays indexed by Node id (ids run
+// 0..Size()-1, see Graph). Passes that only read positions, such as the
+// snapshot build, camera fitting or the layout, stream through two float
+// arrays instead of hopping between hash map nodes.
+//
+// Labels default to the node's id in decimal and are generated when asked
+// for. Labels that are set explicitly are interned: each distinct string is
+// stored once and nodes keep a 4-byte index into the table.
+class NodeStore {
+private:
+    std::vector<float> xs;
+    std::vector<float> ys;
+    std::vector<Color> colors;
+
+    // Index into labelTable, or DEFAULT_LABEL.
+    std::vector<int> labelIndex;
+    std::vector<std::string> labelTable;
+    std::unordered_map<std::string, int> labelLookup;
+
+    static constexpr int DEFAULT_LABEL = -1;
+
+public:
+    void Reserve(size_t count);
+    void Clear();
+
+    // Appends a node with the default label; returns its id.
+    int Add(Vector2 position, Color color);
+
+    int Size() const { return static_cast<int>(xs.size()); }
+    bool Contains(int id) const { return id >= 0 && id < Size(); }
+
+    Vector2 Position(int id) const { return { xs[id], ys[id] }; }
+    void SetPosition(int id, Vector2 position) {
+        xs[id] = position.x;
+        ys[id] = position.y;
+    }
+    const float* X() const { return xs.data(); }
+    const float* Y() const { return ys.data(); }
+
+    Color GetColor(int id) const { return colors[id]; }
+    void SetColor(int id, Color color) { colors[id] = color; }
+    void FillColor(Color color);
+
+    std::string Label(int id) const;
+    // Setting the default label (the id in decimal) stores nothing.
+    void SetLabel(int id, const std::string& label);
+
+    // Distinct explicitly set labels.
+    size_t GetLabelCount() const { return labelTable.size(); }
+};
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Monotone priority queue for unsigned integer keys (Ahuja et al.).
+//
+// Keys pushed must never be smaller than the last key popped, which holds
+// for Dijkstra with non-negative integer weights. Bucket i holds keys whose
+// highest bit differing from the last popped key is bit i-1; a pop that
+// finds bucket 0 empty redistributes the first non-empty bucket around its
+// minimum, and every item moves to a strictly lower bucket each time, so
+// each push costs O(log C) amortized with no comparisons between items.
+//
+// Like the lazy binary heap, a node can be queued several times; callers
+// skip entries whose key is larger than the node's current distance.
+template <typename Value>
+class RadixHeap {
+private:
+    static constexpr int BUCKET_COUNT = 65;
+
+    std::vector<std::pair<uint64_t, Value>> buckets[BUCKET_COUNT];
+    uint64_t last = 0;
+    size_t size = 0;
+
+    static int HighestBit(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(x);
+#else
+        int bit = 0;
+        while (x >>= 1) bit++;
+        return bit;
+#endif
+    }
+
+    int BucketFor(uint64_t key) const {
+        return key == last ? 0 : HighestBit(key ^ last) + 1;
+    }
+
+    void Refill() {
+        int i = 1;
+        while (buckets[i].empty()) i++;
+
+        uint64_t minKey = buckets[i][0].first;
+        for (const auto& item : buckets[i]) {
+            if (item.first < minKey) minKey = item.first;
+        }
+        last = minKey;
+
+        for (const auto& item : buckets[i]) {
+            buckets[BucketFor(item.first)].push_back(item);
+        }
+        buckets[i].clear();
+    }
+
+public:
+    bool Empty() const { return size == 0; }
+    size_t Size() const { return size; }
+
+    void Clear() {
+        for (auto& bucket : buckets) bucket.clear();
+        last = 0;
+        size = 0;
+    }
+
+    // `key` must be >= the last popped key.
+    void Push(uint64_t key, const Value& value) {
+        buckets[BucketFor(key)].push_back({ key, value });
+        size++;
+    }
+
+    // Removes a minimum-key item.
+    std::pair<uint64_t, Value> Pop() {
+        if (buckets[0].empty()) Refill();
+
+        std::pair<uint64_t, Value> item = buckets[0].back();
+        buckets[0].pop_back();
+        size--;
+        return item;
+    }
+};
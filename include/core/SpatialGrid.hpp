@@ -0,0 +1,52 @@
+#pragma once
+#include "Types.hpp"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Uniform grid over node positions. Only occupied cells are stored, so it
+// copes with sparse imported coordinates as well as hand-drawn graphs.
+// Point picking touches at most a 3x3 block of cells when the pick radius is
+// no larger than the cell size.
+class SpatialGrid {
+private:
+    struct Entry {
+        int id;
+        Vector2 position;
+    };
+
+    float cellSize;
+    std::unordered_map<int64_t, std::vector<Entry>> cells;
+    size_t count = 0;
+
+    int minCellX = 0, minCellY = 0, maxCellX = -1, maxCellY = -1;
+
+    int CellCoord(float v) const;
+    static int64_t CellKey(int cx, int cy);
+    const std::vector<Entry>* FindCell(int cx, int cy) const;
+
+    template <typename Fn>
+    void ForEachInBox(Vector2 min, Vector2 max, Fn&& fn) const;
+
+public:
+    explicit SpatialGrid(float cellSize);
+
+    void Insert(int id, Vector2 position);
+    void Remove(int id, Vector2 position);
+    void Move(int id, Vector2 from, Vector2 to);
+    void Clear();
+
+    size_t Size() const { return count; }
+
+    // Closest id whose position lies within `radius` of `point`, or -1.
+    int QueryPoint(Vector2 point, float radius) const;
+
+    // Appends every id inside the axis-aligned box [min, max].
+    void QueryRect(Vector2 min, Vector2 max, std::vector<int>& out) const;
+
+    // Appends every id within `radius` of `center`.
+    void QueryRadius(Vector2 center, float radius, std::vector<int>& out) const;
+
+    // Closest id to `point` regardless of distance, or -1 if the grid is empty.
+    int Nearest(Vector2 point) const;
+};
@@ -0,0 +1,73 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. Capacity is rounded up to a power of two so indices wrap with a
+// mask; head and tail only ever grow and live on separate cache lines, and
+// each side keeps a stale copy of the other's index so the common case
+// touches no shared line at all.
+template <typename T>
+class SpscRing {
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    std::vector<T> slots;
+    size_t mask = 0;
+
+    alignas(CACHE_LINE) std::atomic<size_t> head{ 0 };   // next slot to read
+    size_t cachedTail = 0;                              // consumer's view of tail
+
+    alignas(CACHE_LINE) std::atomic<size_t> tail{ 0 };   // next slot to write
+    size_t cachedHead = 0;                              // producer's view of head
+
+public:
+    explicit SpscRing(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    size_t Capacity() const { return slots.size(); }
+
+    // Producer side. Returns false if the ring is full.
+    bool TryPush(const T& value) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - cachedHead == slots.size()) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t - cachedHead == slots.size()) return false;
+        }
+        slots[t & mask] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false if the ring is empty.
+    bool TryPop(T& value) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == cachedTail) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h == cachedTail) return false;
+        }
+        value = slots[h & mask];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: hands every available item to `fn` and releases the
+    // slots in one store. Returns how many items were consumed.
+    template <typename Fn>
+    size_t ConsumeAll(Fn&& fn) {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t t = tail.load(std::memory_order_acquire);
+        cachedTail = t;
+        for (size_t i = h; i != t; ++i) fn(slots[i & mask]);
+        head.store(t, std::memory_order_release);
+        return t - h;
+    }
+};
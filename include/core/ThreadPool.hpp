@@ -0,0 +1,59 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel preprocessing and batch
+// work. The calling thread takes part as worker 0, so a pool of one thread
+// runs everything inline. Only one Run/ParallelFor may be in flight at a
+// time per pool.
+class ThreadPool {
+private:
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    const std::function<void(int)>* job = nullptr;
+    uint64_t jobGeneration = 0;
+    int running = 0;
+    bool quit = false;
+
+    void WorkerLoop(int worker);
+
+public:
+    // 0 threads means one per hardware thread.
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Including the calling thread.
+    int GetThreadCount() const { return static_cast<int>(threads.size()) + 1; }
+
+    // Calls fn(worker) once on every thread, worker in [0, GetThreadCount()),
+    // and returns when all of them have.
+    void Run(const std::function<void(int worker)>& fn);
+
+    // Hands out [0, count) in chunks of `grain` indices to whichever thread
+    // is free: fn(begin, end, worker). Chunks are claimed dynamically, so
+    // uneven work per index still balances.
+    template <typename Fn>
+    void ParallelFor(int count, int grain, Fn&& fn) {
+        if (count <= 0) return;
+        grain = std::max(grain, 1);
+
+        std::atomic<int> next{ 0 };
+        Run([&](int worker) {
+            for (;;) {
+                int begin = next.fetch_add(grain, std::memory_order_relaxed);
+                if (begin >= count) break;
+                fn(begin, std::min(begin + grain, count), worker);
+            }
+        });
+    }
+};
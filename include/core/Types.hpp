@@ -0,0 +1,35 @@
+#pragma once
+#include <cmath>
+
+// The core library (Graph + solvers) builds without raylib. The GUI target
+// defines GRAPHVIZ_WITH_RAYLIB and gets the real raylib types; everywhere else
+// we declare layout-compatible stand-ins, the same way raymath.h does.
+#if defined(GRAPHVIZ_WITH_RAYLIB)
+#include "raylib.h"
+#else
+
+#if !defined(RL_VECTOR2_TYPE)
+struct Vector2 {
+    float x;
+    float y;
+};
+#define RL_VECTOR2_TYPE
+#endif
+
+#if !defined(RL_COLOR_TYPE)
+struct Color {
+    unsigned char r;
+    unsigned char g;
+    unsigned char b;
+    unsigned char a;
+};
+#define RL_COLOR_TYPE
+#endif
+
+#endif
+
+inline float Distance(Vector2 a, Vector2 b) {
+    float dx = a.x - b.x;
+    float dy = a.y - b.y;
+    return std::sqrt(dx * dx + dy * dy);
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "raylib.h"
+#include "../core/Graph.hpp"
+#include "../algorithms/ISolver.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Raylib view of the model. The core library never draws; everything that
+// touches the window goes through here.
+//
+// Drawing is split in two layers:
+//  * static: edges and weight labels. Their geometry is rebuilt only when
+//    Graph::GetVersion() moves, and they are rendered into a screen-sized
+//    texture only when the graph or the camera changes. A bidirectional edge
+//    is drawn once.
+//  * dynamic: nodes, whose colors change every step while a solver runs.
+//    Only nodes inside the viewport (found through the graph's spatial
+//    index) are drawn.
+class Renderer {
+private:
+    struct EdgeSegment {
+        Vector2 a;
+        Vector2 b;
+        std::string label;
+    };
+
+    const Graph* cachedGraph = nullptr;
+    uint64_t cachedVersion = UINT64_MAX;
+    std::vector<EdgeSegment> edges;
+
+    RenderTexture2D staticLayer = {};
+    uint64_t layerVersion = UINT64_MAX;
+    Camera2D layerCamera = {};
+
+    std::vector<Vector2> edgeVertices;
+
+    void RebuildEdgeCache(const Graph& graph);
+    void RenderStaticLayer(Font font, const Camera2D& camera, Rectangle view);
+    void DrawEdgeVertices() const;
+
+public:
+    void Draw(const Graph& graph, Font font, const Camera2D& camera);
+
+    // Releases the GPU texture; call before CloseWindow().
+    void Unload();
+};
+
+// World-space rectangle currently shown by `camera` on a full-window view.
+Rectangle GetCameraView(const Camera2D& camera);
+
+// Routes solver overlays (ISolver::DrawDebug) to raylib text calls.
+class RaylibDebugCanvas : public IDebugCanvas {
+private:
+    Font font;
+
+public:
+    explicit RaylibDebugCanvas(Font font) : font(font) {}
+
+    void DrawLabel(const char* text, Vector2 position, float fontSize, Color color) override;
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include "../algorithms/SolverWorker.hpp"
+#include <string>
+
+enum class StepMode {
+    FIXED_DELAY,        // one Step every `stepDelay` seconds (the classic animation)
+    STEPS_PER_FRAME,    // exactly `stepsPerFrame` Steps each frame
+    TIME_BUDGET,        // as many Steps as fit in `budgetMs` of each frame
+    RUN_TO_COMPLETION   // no limit: the worker runs flat out until done
+};
+
+// Decides how far a running solver advances in one frame. The main loop
+// asks for a quota once per frame and grants it to the SolverWorker; the
+// solver runs on its own thread, so rendering and input keep their frame
+// rate in every mode, no matter how large the graph is.
+class StepScheduler {
+private:
+    StepMode mode = StepMode::FIXED_DELAY;
+    float stepDelay = 0.1f;
+    int stepsPerFrame = 1;
+    float budgetMs = 4.0f;
+
+    float timer = 0.0f;
+
+public:
+    // This frame's share of steps (zero steps if none is due yet).
+    StepQuota NextQuota(float dt);
+
+    // Forgets the FIXED_DELAY timer; call when a run (re)starts.
+    void Reset();
+
+    StepMode GetMode() const { return mode; }
+    void SetMode(StepMode newMode);
+    void NextMode();
+
+    // Speeds up / slows down the current mode by a factor of two.
+    void Faster();
+    void Slower();
+
+    // Short HUD text, e.g. "budget 4.0 ms".
+    std::string Describe() const;
+};
@@ -0,0 +1,148 @@
+#include "../../include/algorithms/Algorithms.hpp"
+#include <algorithm>
+#include <cstdio>
+
+constexpr float INF_DISTANCE = std::numeric_limits<float>::infinity();
+
+void BidirectionalSearch::Initialize(const CsrGraph* g, int start, int end) {
+    csr = g;
+    startIndex = csr->ToDense(start);
+    endIndex = csr->ToDense(end);
+    if (ProvablyUnreachable(csr, startIndex, endIndex)) startIndex = -1;
+
+    if (csr->GetBuildId() != reverseSourceId) {
+        reverse.BuildReverse(*csr);
+        reverseSourceId = csr->GetBuildId();
+    }
+    sides[0].graph = csr;
+    sides[1].graph = &reverse;
+
+    for (Side& side : sides) {
+        if (!side.workspace) side.workspace = SolverWorkspacePool::Shared().Acquire();
+        side.workspace->Begin(csr->NodeCount());
+    }
+
+    bestDistance = INF_DISTANCE;
+    meetingNode = -1;
+    expandedCount = 0;
+    if (startIndex == -1 || endIndex == -1) return;
+
+    int roots[2] = { startIndex, endIndex };
+    for (int s = 0; s < 2; ++s) {
+        SolverWorkspace& workspace = *sides[s].workspace;
+        workspace.Touch(roots[s]).dist = 0.0f;
+        workspace.Reached().push_back(roots[s]);
+        workspace.Heap().PushOrDecrease(roots[s], s == 0 ? Potential(roots[s]) : -Potential(roots[s]));
+    }
+
+    if (startIndex == endIndex) {
+        bestDistance = 0.0f;
+        meetingNode = startIndex;
+    }
+
+    Emit(SearchEventKind::START, startIndex);
+}
+
+SolverState BidirectionalSearch::Step() {
+    IndexedDaryHeap<float>& forward = sides[0].workspace->Heap();
+    IndexedDaryHeap<float>& backward = sides[1].workspace->Heap();
+
+    if (forward.Empty() || backward.Empty()) {
+        return meetingNode != -1 ? SolverState::FINISHED_FOUND_PATH : SolverState::FINISHED_NO_PATH;
+    }
+
+    if (forward.TopKey() + backward.TopKey() >= bestDistance) {
+        return SolverState::FINISHED_FOUND_PATH;
+    }
+
+    Expand(forward.TopKey() <= backward.TopKey() ? 0 : 1);
+    return SolverState::RUNNING;
+}
+
+void BidirectionalSearch::Expand(int s) {
+    const Side& side = sides[s];
+    SolverWorkspace& workspace = *side.workspace;
+    const SolverWorkspace& other = *sides[1 - s].workspace;
+    const bool isForward = (s == 0);
+
+    int currentId = workspace.Heap().Pop();
+    float currentDist = workspace.Distance(currentId);
+    expandedCount++;
+
+    if (currentId != startIndex && currentId != endIndex) {
+        Emit(isForward ? SearchEventKind::SETTLED : SearchEventKind::BACKWARD_SETTLED, currentId);
+    }
+
+    const CsrGraph* graph = side.graph;
+    for (int e = graph->EdgesBegin(currentId); e < graph->EdgesEnd(currentId); ++e) {
+        int neighborId = graph->Target(e);
+        float newDist = currentDist + graph->Weight(e);
+
+        SolverWorkspace::NodeState& neighbor = workspace.Touch(neighborId);
+        if (newDist < neighbor.dist) {
+            bool isFirstDiscovery = (neighbor.dist == INF_DISTANCE);
+            if (isFirstDiscovery) workspace.Reached().push_back(neighborId);
+
+            neighbor.dist = newDist;
+            neighbor.parent = currentId;
+
+            float potential = Potential(neighborId);
+            workspace.Heap().PushOrDecrease(neighborId, newDist + (isForward ? potential : -potential));
+
+            // A path through this edge that the other side already reached.
+            float through = newDist + other.Distance(neighborId);
+            if (through < bestDistance) {
+                bestDistance = through;
+                meetingNode = neighborId;
+            }
+
+            if (neighborId != startIndex && neighborId != endIndex) {
+                if (isForward) {
+                    Emit(isFirstDiscovery ? SearchEventKind::DISCOVERED : SearchEventKind::RELAXED, neighborId);
+                } else {
+                    Emit(SearchEventKind::BACKWARD_DISCOVERED, neighborId);
+                }
+            }
+        }
+    }
+}
+
+std::vector<int> BidirectionalSearch::GetPath() const {
+    std::vector<int> path;
+    if (meetingNode == -1) return path;
+
+    // Start -> meeting node through the forward parents...
+    for (int curr = meetingNode; curr != -1; curr = sides[0].workspace->Parent(curr)) {
+        path.push_back(csr->ToNodeId(curr));
+    }
+    std::reverse(path.begin(), path.end());
+
+    // ...then on to the end through the backward ones.
+    for (int curr = sides[1].workspace->Parent(meetingNode); curr != -1; curr = sides[1].workspace->Parent(curr)) {
+        path.push_back(csr->ToNodeId(curr));
+    }
+    return path;
+}
+
+void BidirectionalSearch::DrawDebug(IDebugCanvas& canvas) {
+    for (int s = 0; s < 2; ++s) {
+        const SolverWorkspace& workspace = *sides[s].workspace;
+        for (int u : workspace.Reached()) {
+            Vector2 pos = csr->Position(u);
+
+            char buffer[16];
+            std::snprintf(buffer, sizeof(buffer), "%.1f", workspace.Distance(u));
+
+            // Forward distances above the node, backward ones below.
+            Vector2 textPos = { pos.x - 10, s == 0 ? pos.y - 35 : pos.y + 20 };
+            canvas.DrawLabel(buffer, textPos, 20, s == 0 ? COLOR_TEXT : COLOR_TEXT_DIM);
+        }
+    }
+}
+
+float BidirectionalAStarSolver::Potential(int u) const {
+    if (!csr || startIndex == -1 || endIndex == -1) return 0.0f;
+
+    Vector2 pos = csr->Position(u);
+    return 0.5f * (Distance(pos, csr->Position(endIndex)) - Distance(csr->Position(startIndex), pos));
+}
@@ -0,0 +1,169 @@
+#include "../../include/algorithms/Algorithms.hpp"
+#include <algorithm>
+#include <cstdio>
+
+constexpr float INF_DISTANCE = std::numeric_limits<float>::infinity();
+
+void ChSolver::Initialize(const CsrGraph* g, int start, int end) {
+    csr = g;
+    startIndex = csr->ToDense(start);
+    endIndex = csr->ToDense(end);
+    if (ProvablyUnreachable(csr, startIndex, endIndex)) startIndex = -1;
+
+    if (shared && shared->Matches(*csr)) {
+        hierarchy = shared;
+    } else {
+        if (!own.Matches(*csr)) own.Build(*csr);
+        hierarchy = &own;
+    }
+
+    // Only the nodes the last query reached need resetting, which keeps
+    // Initialize cheap next to the query itself on big graphs.
+    for (Side& side : sides) {
+        side.heap.Reset(csr->NodeCount());
+        if (side.dist.size() != static_cast<size_t>(csr->NodeCount())) {
+            side.dist.assign(csr->NodeCount(), INF_DISTANCE);
+            side.parent.assign(csr->NodeCount(), -1);
+        } else {
+            for (int u : side.reached) {
+                side.dist[u] = INF_DISTANCE;
+                side.parent[u] = -1;
+            }
+        }
+        side.reached.clear();
+    }
+
+    bestDistance = INF_DISTANCE;
+    meetingNode = -1;
+    expandedCount = 0;
+    if (startIndex == -1 || endIndex == -1) return;
+
+    int roots[2] = { startIndex, endIndex };
+    for (int s = 0; s < 2; ++s) {
+        sides[s].dist[roots[s]] = 0.0f;
+        sides[s].reached.push_back(roots[s]);
+        sides[s].heap.PushOrDecrease(roots[s], 0.0f);
+    }
+
+    if (startIndex == endIndex) {
+        bestDistance = 0.0f;
+        meetingNode = startIndex;
+    }
+
+    Emit(SearchEventKind::START, startIndex);
+}
+
+SolverState ChSolver::Step() {
+    bool active[2];
+    for (int s = 0; s < 2; ++s) {
+        active[s] = !sides[s].heap.Empty() && sides[s].heap.TopKey() < bestDistance;
+    }
+
+    if (!active[0] && !active[1]) {
+        return meetingNode != -1 ? SolverState::FINISHED_FOUND_PATH : SolverState::FINISHED_NO_PATH;
+    }
+
+    int s = !active[1] ? 0 : !active[0] ? 1 : (sides[0].heap.TopKey() <= sides[1].heap.TopKey() ? 0 : 1);
+    Expand(s);
+    return SolverState::RUNNING;
+}
+
+bool ChSolver::IsStalled(int s, int u) const {
+    const Side& side = sides[s];
+    float d = side.dist[u];
+
+    // Edges from higher nodes into u (forward) or from u to higher nodes
+    // (backward): the other direction of what this side relaxes.
+    if (s == 0) {
+        for (int e = hierarchy->DownBegin(u); e < hierarchy->DownEnd(u); ++e) {
+            const ChEdge& edge = hierarchy->DownEdge(e);
+            if (side.dist[edge.node] + edge.weight < d) return true;
+        }
+    } else {
+        for (int e = hierarchy->UpBegin(u); e < hierarchy->UpEnd(u); ++e) {
+            const ChEdge& edge = hierarchy->UpEdge(e);
+            if (side.dist[edge.node] + edge.weight < d) return true;
+        }
+    }
+    return false;
+}
+
+void ChSolver::Expand(int s) {
+    Side& side = sides[s];
+    const Side& other = sides[1 - s];
+    const bool isForward = (s == 0);
+
+    int currentId = side.heap.Pop();
+    float currentDist = side.dist[currentId];
+    expandedCount++;
+
+    if (currentId != startIndex && currentId != endIndex) {
+        Emit(isForward ? SearchEventKind::SETTLED : SearchEventKind::BACKWARD_SETTLED, currentId);
+    }
+
+    if (IsStalled(s, currentId)) return;
+
+    int begin = isForward ? hierarchy->UpBegin(currentId) : hierarchy->DownBegin(currentId);
+    int end = isForward ? hierarchy->UpEnd(currentId) : hierarchy->DownEnd(currentId);
+    for (int e = begin; e < end; ++e) {
+        const ChEdge& edge = isForward ? hierarchy->UpEdge(e) : hierarchy->DownEdge(e);
+        int neighborId = edge.node;
+        float newDist = currentDist + edge.weight;
+
+        if (newDist < side.dist[neighborId]) {
+            bool isFirstDiscovery = (side.dist[neighborId] == INF_DISTANCE);
+            if (isFirstDiscovery) side.reached.push_back(neighborId);
+
+            side.dist[neighborId] = newDist;
+            side.parent[neighborId] = currentId;
+            side.heap.PushOrDecrease(neighborId, newDist);
+
+            float through = newDist + other.dist[neighborId];
+            if (through < bestDistance) {
+                bestDistance = through;
+                meetingNode = neighborId;
+            }
+
+            if (neighborId != startIndex && neighborId != endIndex) {
+                if (isForward) {
+                    Emit(isFirstDiscovery ? SearchEventKind::DISCOVERED : SearchEventKind::RELAXED, neighborId);
+                } else {
+                    Emit(SearchEventKind::BACKWARD_DISCOVERED, neighborId);
+                }
+            }
+        }
+    }
+}
+
+std::vector<int> ChSolver::GetPath() const {
+    std::vector<int> path;
+    if (meetingNode == -1) return path;
+
+    // Hierarchy nodes: start up to the meeting node, then down to the end.
+    std::vector<int> route;
+    for (int curr = meetingNode; curr != -1; curr = sides[0].parent[curr]) route.push_back(curr);
+    std::reverse(route.begin(), route.end());
+    for (int curr = sides[1].parent[meetingNode]; curr != -1; curr = sides[1].parent[curr]) route.push_back(curr);
+
+    std::vector<int> dense = { route.front() };
+    for (size_t i = 1; i < route.size(); ++i) hierarchy->Unpack(route[i - 1], route[i], dense);
+
+    path.reserve(dense.size());
+    for (int u : dense) path.push_back(csr->ToNodeId(u));
+    return path;
+}
+
+void ChSolver::DrawDebug(IDebugCanvas& canvas) {
+    for (int s = 0; s < 2; ++s) {
+        const Side& side = sides[s];
+        for (int u : side.reached) {
+            Vector2 pos = csr->Position(u);
+
+            char buffer[16];
+            std::snprintf(buffer, sizeof(buffer), "%.1f", side.dist[u]);
+
+            Vector2 textPos = { pos.x - 10, s == 0 ? pos.y - 35 : pos.y + 20 };
+            canvas.DrawLabel(buffer, textPos, 20, s == 0 ? COLOR_TEXT : COLOR_TEXT_DIM);
+        }
+    }
+}
@@ -0,0 +1,474 @@
+#include "../../include/algorithms/ContractionHierarchy.hpp"
+#include "../../include/core/ThreadPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <utility>
+
+constexpr float INF_DISTANCE = std::numeric_limits<float>::infinity();
+
+static bool Fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+// PREPROCESSING
+
+namespace {
+
+using Adjacency = std::vector<std::vector<ChEdge>>;
+
+struct Shortcut {
+    int from;
+    int to;
+    float weight;
+    int middle;
+};
+
+// Lists are kept sorted by node, so edge lookups stay logarithmic at the
+// high-degree nodes that build up near the top of the hierarchy.
+std::vector<ChEdge>::iterator FindNeighbor(std::vector<ChEdge>& edges, int node) {
+    return std::lower_bound(edges.begin(), edges.end(), node,
+                            [](const ChEdge& edge, int n) { return edge.node < n; });
+}
+
+// Keeps at most one edge per neighbor: the cheapest.
+void AddOrLower(std::vector<ChEdge>& edges, int node, float weight, int middle) {
+    auto it = FindNeighbor(edges, node);
+    if (it == edges.end() || it->node != node) {
+        edges.insert(it, { node, weight, middle });
+    } else if (weight < it->weight) {
+        it->weight = weight;
+        it->middle = middle;
+    }
+}
+
+void RemoveEdge(std::vector<ChEdge>& edges, int node) {
+    auto it = FindNeighbor(edges, node);
+    if (it != edges.end() && it->node == node) edges.erase(it);
+}
+
+// Tie-breaker for equal priorities that does not favor low indices, which
+// would contract whole grid rows in order and grow long shortcut chains.
+uint32_t Scramble(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+// Local Dijkstra on the remaining graph, one per thread. Distances of nodes
+// it did not get to settle are still lengths of real paths, so they are
+// valid (if pessimistic) witnesses.
+class WitnessSearch {
+private:
+    std::vector<float> dist;
+    std::vector<int> touched;
+    std::vector<std::pair<float, int>> heap;
+    std::vector<uint8_t> isTarget;
+
+public:
+    // Nodes whose distance the next Run needs; it stops once all are settled.
+    void MarkTarget(int v, bool mark) { isTarget[v] = mark; }
+
+    void Resize(size_t nodeCount) {
+        dist.assign(nodeCount, INF_DISTANCE);
+        isTarget.assign(nodeCount, 0);
+        touched.clear();
+    }
+
+    void Run(const Adjacency& out, int source, int skip, const std::vector<uint8_t>* blocked,
+             float maxDistance, int settleLimit, int targetCount) {
+        for (int u : touched) dist[u] = INF_DISTANCE;
+        touched.clear();
+        heap.clear();
+
+        auto later = std::greater<std::pair<float, int>>();
+        dist[source] = 0.0f;
+        touched.push_back(source);
+        heap.push_back({ 0.0f, source });
+
+        int settled = 0;
+        while (!heap.empty() && settled < settleLimit) {
+            std::pop_heap(heap.begin(), heap.end(), later);
+            auto [d, u] = heap.back();
+            heap.pop_back();
+            if (d > dist[u]) continue;
+            if (d > maxDistance) break;
+            settled++;
+            if (isTarget[u] && --targetCount == 0) break;
+
+            for (const ChEdge& edge : out[u]) {
+                int v = edge.node;
+                if (v == skip || (blocked && (*blocked)[v])) continue;
+
+                float nd = d + edge.weight;
+                if (nd < dist[v] && nd <= maxDistance) {
+                    if (dist[v] == INF_DISTANCE) touched.push_back(v);
+                    dist[v] = nd;
+                    heap.push_back({ nd, v });
+                    std::push_heap(heap.begin(), heap.end(), later);
+                }
+            }
+        }
+    }
+
+    float Distance(int v) const { return dist[v]; }
+};
+
+// Shortcuts needed to contract `u` now: one per in-neighbor x and
+// out-neighbor y with no witness x -> y avoiding u (and `blocked`) at most
+// as long as x -> u -> y. Returns their number; also collects them if asked.
+int FindShortcuts(const Adjacency& out, const Adjacency& in, int u, const std::vector<uint8_t>* blocked,
+                  int settleLimit, WitnessSearch& search, std::vector<Shortcut>* shortcuts) {
+    int count = 0;
+    for (const ChEdge& inEdge : in[u]) {
+        int x = inEdge.node;
+
+        float maxOut = -1.0f;
+        int targetCount = 0;
+        for (const ChEdge& outEdge : out[u]) {
+            if (outEdge.node == x) continue;
+            maxOut = std::max(maxOut, outEdge.weight);
+            search.MarkTarget(outEdge.node, true);
+            targetCount++;
+        }
+        if (targetCount == 0) continue;
+
+        search.Run(out, x, u, blocked, inEdge.weight + maxOut, settleLimit, targetCount);
+
+        for (const ChEdge& outEdge : out[u]) {
+            int y = outEdge.node;
+            if (y == x) continue;
+            search.MarkTarget(y, false);
+
+            float via = inEdge.weight + outEdge.weight;
+            if (search.Distance(y) > via) {
+                count++;
+                if (shortcuts) shortcuts->push_back({ x, y, via, u });
+            }
+        }
+    }
+    return count;
+}
+
+void Flatten(const Adjacency& lists, std::vector<int>& offsets, std::vector<ChEdge>& edges) {
+    offsets.assign(lists.size() + 1, 0);
+    for (size_t u = 0; u < lists.size(); ++u) {
+        offsets[u + 1] = offsets[u] + static_cast<int>(lists[u].size());
+    }
+    edges.clear();
+    edges.reserve(offsets.back());
+    for (const std::vector<ChEdge>& list : lists) edges.insert(edges.end(), list.begin(), list.end());
+}
+
+} // namespace
+
+void ContractionHierarchy::Build(const CsrGraph& graph, const ChBuildOptions& options, ChBuildStats* stats) {
+    auto buildStart = std::chrono::steady_clock::now();
+    Clear();
+
+    const int n = graph.NodeCount();
+    ThreadPool pool(options.threadCount);
+    std::vector<WitnessSearch> searches(pool.GetThreadCount());
+    for (WitnessSearch& search : searches) search.Resize(n);
+
+    // The remaining graph; contracted nodes are removed from it.
+    Adjacency out(n), in(n);
+    for (int u = 0; u < n; ++u) {
+        for (int e = graph.EdgesBegin(u); e < graph.EdgesEnd(u); ++e) {
+            int v = graph.Target(e);
+            if (v == u) continue;
+            AddOrLower(out[u], v, graph.Weight(e), -1);
+            AddOrLower(in[v], u, graph.Weight(e), -1);
+        }
+    }
+
+    // Priority: edge difference, plus terms that spread contraction evenly
+    // (contracted neighbors) and keep the hierarchy shallow (level). The
+    // last two are kept current; the edge difference needs witness searches,
+    // so it is only redone for nodes whose neighborhood changed (`stale`),
+    // and only once they come up as candidates.
+    std::vector<int> edgeDifference(n);
+    std::vector<int> contractedNeighbors(n, 0);
+    std::vector<int> level(n, 0);
+    std::vector<uint8_t> stale(n, 0);
+
+    auto setEdgeDifference = [&](int u, int shortcuts) {
+        edgeDifference[u] = 2 * (shortcuts - static_cast<int>(in[u].size() + out[u].size()));
+        stale[u] = 0;
+    };
+    auto before = [&](int a, int b) {
+        int pa = edgeDifference[a] + contractedNeighbors[a] + level[a];
+        int pb = edgeDifference[b] + contractedNeighbors[b] + level[b];
+        if (pa != pb) return pa < pb;
+        uint32_t ha = Scramble(a), hb = Scramble(b);
+        return ha != hb ? ha < hb : a < b;
+    };
+    auto isMinimum = [&](int u) {
+        for (const ChEdge& edge : out[u]) if (before(edge.node, u)) return false;
+        for (const ChEdge& edge : in[u]) if (before(edge.node, u)) return false;
+        return true;
+    };
+
+    std::vector<int> remaining(n);
+    for (int u = 0; u < n; ++u) remaining[u] = u;
+    pool.ParallelFor(n, 64, [&](int begin, int end, int worker) {
+        for (int u = begin; u < end; ++u) {
+            setEdgeDifference(u, FindShortcuts(out, in, u, nullptr, options.witnessSettleLimit, searches[worker], nullptr));
+        }
+    });
+
+    ownedRanks.assign(n, -1);
+    Adjacency upLists(n), downLists(n);
+    std::vector<uint8_t> inRound(n, 0);
+    std::vector<uint8_t> updated;
+    std::vector<int> round, rest;
+    std::vector<std::vector<Shortcut>> roundShortcuts;
+    int nextRank = 0;
+    int rounds = 0;
+
+    while (!remaining.empty()) {
+        // Local priority minima: never adjacent to each other.
+        pool.ParallelFor(static_cast<int>(remaining.size()), 256, [&](int begin, int end, int) {
+            for (int i = begin; i < end; ++i) inRound[remaining[i]] = isMinimum(remaining[i]);
+        });
+
+        round.clear();
+        rest.clear();
+        for (int u : remaining) (inRound[u] ? round : rest).push_back(u);
+
+        // One search per candidate, avoiding all of them: its shortcuts are
+        // what contracting the candidate next to any of the others needs, and
+        // their count updates a stale priority without a second search.
+        roundShortcuts.resize(round.size());
+        updated.assign(round.size(), 0);
+        pool.ParallelFor(static_cast<int>(round.size()), 16, [&](int begin, int end, int worker) {
+            for (int i = begin; i < end; ++i) {
+                int u = round[i];
+                roundShortcuts[i].clear();
+                int shortcuts = FindShortcuts(out, in, u, &inRound, options.witnessSettleLimit,
+                                              searches[worker], &roundShortcuts[i]);
+                if (stale[u]) {
+                    setEdgeDifference(u, shortcuts);
+                    updated[i] = 1;
+                }
+            }
+        });
+
+        // A candidate whose priority went up may have stopped being a
+        // minimum; it waits for a later round. Neighbors of candidates are
+        // not candidates, so the check does not depend on the order.
+        size_t kept = 0;
+        for (size_t i = 0; i < round.size(); ++i) {
+            int u = round[i];
+            if (updated[i] && !isMinimum(u)) {
+                rest.push_back(u);
+                continue;
+            }
+            round[kept] = u;
+            roundShortcuts[kept].swap(roundShortcuts[i]);
+            kept++;
+        }
+        for (int u : round) inRound[u] = 0;
+        round.resize(kept);
+        roundShortcuts.resize(kept);
+
+        // Every edge left at a node goes to a higher rank: freeze them.
+        auto touch = [&](int v, int u) {
+            contractedNeighbors[v]++;
+            level[v] = std::max(level[v], level[u] + 1);
+            stale[v] = 1;
+        };
+        for (int u : round) {
+            ownedRanks[u] = nextRank++;
+            for (const ChEdge& edge : out[u]) {
+                RemoveEdge(in[edge.node], u);
+                touch(edge.node, u);
+            }
+            for (const ChEdge& edge : in[u]) {
+                RemoveEdge(out[edge.node], u);
+                touch(edge.node, u);
+            }
+            upLists[u].swap(out[u]);
+            downLists[u].swap(in[u]);
+        }
+
+        for (const std::vector<Shortcut>& shortcuts : roundShortcuts) {
+            for (const Shortcut& s : shortcuts) {
+                AddOrLower(out[s.from], s.to, s.weight, s.middle);
+                AddOrLower(in[s.to], s.from, s.weight, s.middle);
+            }
+        }
+
+        remaining.swap(rest);
+        if (kept > 0) rounds++;
+    }
+
+    Flatten(upLists, ownedUpOffsets, ownedUpEdges);
+    Flatten(downLists, ownedDownOffsets, ownedDownEdges);
+
+    // Every shortcut sits in exactly one list: at its lower-ranked end.
+    for (const ChEdge& edge : ownedUpEdges) shortcutCount += edge.middle != -1;
+    for (const ChEdge& edge : ownedDownEdges) shortcutCount += edge.middle != -1;
+
+    nodeCount = n;
+    upEdgeCount = static_cast<int>(ownedUpEdges.size());
+    downEdgeCount = static_cast<int>(ownedDownEdges.size());
+    sourceBuildId = graph.GetBuildId();
+    ranks = ownedRanks.data();
+    upOffsets = ownedUpOffsets.data();
+    upEdges = ownedUpEdges.data();
+    downOffsets = ownedDownOffsets.data();
+    downEdges = ownedDownEdges.data();
+
+    if (stats) {
+        stats->rounds = rounds;
+        stats->shortcutCount = shortcutCount;
+        stats->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - buildStart).count();
+    }
+}
+
+// STORAGE
+
+bool ContractionHierarchy::Attach(const MappedGraphFile& file, std::string* error) {
+    Clear();
+
+    const CsrGraph& graph = file.GetCsr();
+    const uint64_t n = graph.NodeCount();
+
+    auto section = [&](uint32_t tag, uint64_t* size) { return file.FindSection(tag, size); };
+    uint64_t infoSize = 0, ranksSize = 0, upOffsetsSize = 0, upEdgesSize = 0, downOffsetsSize = 0, downEdgesSize = 0;
+    auto fileInfo = static_cast<const ChFileInfo*>(section(SECTION_CH_INFO, &infoSize));
+    auto fileRanks = static_cast<const int*>(section(SECTION_CH_RANKS, &ranksSize));
+    auto fileUpOffsets = static_cast<const int*>(section(SECTION_CH_UP_OFFSETS, &upOffsetsSize));
+    auto fileUpEdges = static_cast<const ChEdge*>(section(SECTION_CH_UP_EDGES, &upEdgesSize));
+    auto fileDownOffsets = static_cast<const int*>(section(SECTION_CH_DOWN_OFFSETS, &downOffsetsSize));
+    auto fileDownEdges = static_cast<const ChEdge*>(section(SECTION_CH_DOWN_EDGES, &downEdgesSize));
+
+    if (!fileInfo) return Fail(error, "no contraction hierarchy stored");
+    if (infoSize != sizeof(ChFileInfo) || fileInfo->version != CH_FILE_VERSION) {
+        return Fail(error, "unsupported contraction hierarchy version");
+    }
+    if (!fileRanks || !fileUpOffsets || !fileDownOffsets ||
+        ranksSize != n * sizeof(int) || upOffsetsSize != (n + 1) * sizeof(int) ||
+        downOffsetsSize != (n + 1) * sizeof(int) ||
+        upEdgesSize % sizeof(ChEdge) != 0 || downEdgesSize % sizeof(ChEdge) != 0) {
+        return Fail(error, "malformed contraction hierarchy sections");
+    }
+
+    // Everything a query or Unpack relies on: ranks form a permutation,
+    // edges lead upward, and shortcuts bypass strictly lower nodes (so
+    // unpacking terminates).
+    std::vector<uint8_t> seen(n, 0);
+    for (uint64_t u = 0; u < n; ++u) {
+        int r = fileRanks[u];
+        if (r < 0 || static_cast<uint64_t>(r) >= n || seen[r]) return Fail(error, "contraction hierarchy ranks are not a permutation");
+        seen[r] = 1;
+    }
+    auto checkEdges = [&](const int* offsets, const ChEdge* edges, uint64_t edgesSize) {
+        if (offsets[0] != 0 || static_cast<uint64_t>(offsets[n]) * sizeof(ChEdge) != edgesSize) return false;
+        for (uint64_t u = 0; u < n; ++u) {
+            if (offsets[u] > offsets[u + 1]) return false;
+            for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+                const ChEdge& edge = edges[e];
+                if (edge.node < 0 || static_cast<uint64_t>(edge.node) >= n) return false;
+                if (fileRanks[edge.node] <= fileRanks[u]) return false;
+                if (edge.middle == -1) continue;
+                if (edge.middle < 0 || static_cast<uint64_t>(edge.middle) >= n ||
+                    fileRanks[edge.middle] >= fileRanks[u]) return false;
+            }
+        }
+        return true;
+    };
+    if (!checkEdges(fileUpOffsets, fileUpEdges, upEdgesSize) ||
+        !checkEdges(fileDownOffsets, fileDownEdges, downEdgesSize)) {
+        return Fail(error, "inconsistent contraction hierarchy edges");
+    }
+
+    nodeCount = static_cast<int>(n);
+    upEdgeCount = static_cast<int>(upEdgesSize / sizeof(ChEdge));
+    downEdgeCount = static_cast<int>(downEdgesSize / sizeof(ChEdge));
+    shortcutCount = fileInfo->shortcutCount;
+    sourceBuildId = graph.GetBuildId();
+    ranks = fileRanks;
+    upOffsets = fileUpOffsets;
+    upEdges = fileUpEdges;
+    downOffsets = fileDownOffsets;
+    downEdges = fileDownEdges;
+    return true;
+}
+
+void ContractionHierarchy::Clear() {
+    nodeCount = 0;
+    upEdgeCount = 0;
+    downEdgeCount = 0;
+    shortcutCount = 0;
+    sourceBuildId = 0;
+
+    ranks = nullptr;
+    upOffsets = nullptr;
+    upEdges = nullptr;
+    downOffsets = nullptr;
+    downEdges = nullptr;
+
+    ownedRanks.clear();
+    ownedUpOffsets.clear();
+    ownedUpEdges.clear();
+    ownedDownOffsets.clear();
+    ownedDownEdges.clear();
+}
+
+std::vector<GraphFileBlob> ContractionHierarchy::GetSections() {
+    if (!ranks) return {};
+
+    info = {};
+    info.version = CH_FILE_VERSION;
+    info.shortcutCount = shortcutCount;
+
+    const uint64_t offsetsSize = (static_cast<uint64_t>(nodeCount) + 1) * sizeof(int);
+    return {
+        { SECTION_CH_INFO, &info, sizeof(info) },
+        { SECTION_CH_RANKS, ranks, static_cast<uint64_t>(nodeCount) * sizeof(int) },
+        { SECTION_CH_UP_OFFSETS, upOffsets, offsetsSize },
+        { SECTION_CH_UP_EDGES, upEdges, static_cast<uint64_t>(upEdgeCount) * sizeof(ChEdge) },
+        { SECTION_CH_DOWN_OFFSETS, downOffsets, offsetsSize },
+        { SECTION_CH_DOWN_EDGES, downEdges, static_cast<uint64_t>(downEdgeCount) * sizeof(ChEdge) },
+    };
+}
+
+// PATH UNPACKING
+
+const ChEdge* ContractionHierarchy::FindEdge(int from, int to) const {
+    const ChEdge* best = nullptr;
+    if (ranks[from] < ranks[to]) {
+        for (int e = UpBegin(from); e < UpEnd(from); ++e) {
+            if (upEdges[e].node == to && (!best || upEdges[e].weight < best->weight)) best = &upEdges[e];
+        }
+    } else {
+        for (int e = DownBegin(to); e < DownEnd(to); ++e) {
+            if (downEdges[e].node == from && (!best || downEdges[e].weight < best->weight)) best = &downEdges[e];
+        }
+    }
+    return best;
+}
+
+void ContractionHierarchy::Unpack(int from, int to, std::vector<int>& path) const {
+    std::vector<std::pair<int, int>> pending = { { from, to } };
+    while (!pending.empty()) {
+        auto [a, b] = pending.back();
+        pending.pop_back();
+
+        const ChEdge* edge = FindEdge(a, b);
+        if (!edge || edge->middle == -1) {
+            path.push_back(b);
+            continue;
+        }
+        // a -> middle comes first, so it goes on top.
+        pending.push_back({ edge->middle, b });
+        pending.push_back({ a, edge->middle });
+    }
+}
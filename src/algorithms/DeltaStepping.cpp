@@ -0,0 +1,378 @@
+#include "../../include/algorithms/DeltaStepping.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+constexpr float INF_DISTANCE = std::numeric_limits<float>::infinity();
+
+// Edge weights looked at by ChooseDelta.
+constexpr int DELTA_SAMPLE_SIZE = 4096;
+
+// Light edges per node ChooseDelta aims for.
+constexpr double LIGHT_EDGES_PER_NODE = 2.0;
+
+// Below this many entries, merging the per-thread lists is not worth
+// waking the pool.
+constexpr size_t PARALLEL_GATHER_MIN = 1 << 14;
+
+// Bucket slots per worker at most; the rest goes to the overflow list.
+constexpr size_t MAX_RING_SIZE = 1 << 12;
+
+// Bucket numbers are clamped here before the float to size_t conversion, so
+// huge or infinite distances still give a valid (if shared) bucket.
+constexpr double MAX_BUCKET = 1e18;
+
+constexpr int RELAX_GRAIN = 64;
+constexpr int FILL_GRAIN = 1 << 14;
+
+// Non-negative floats order the same as their bit patterns, so a packed
+// word compares by distance first.
+static uint64_t Pack(float distance, int parent) {
+    uint32_t bits;
+    std::memcpy(&bits, &distance, sizeof(bits));
+    return (static_cast<uint64_t>(bits) << 32) | static_cast<uint32_t>(parent);
+}
+
+static float DistanceOf(uint64_t word) {
+    uint32_t bits = static_cast<uint32_t>(word >> 32);
+    float distance;
+    std::memcpy(&distance, &bits, sizeof(distance));
+    return distance;
+}
+
+static int ParentOf(uint64_t word) {
+    return static_cast<int>(static_cast<uint32_t>(word));
+}
+
+static const uint64_t UNREACHED = Pack(INF_DISTANCE, -1);
+
+// Appends every list in `parts` to `out` (in order) and empties them.
+static void Concatenate(ThreadPool& pool, const std::vector<std::vector<int>*>& parts, std::vector<int>& out) {
+    std::vector<size_t> offsets(parts.size());
+    size_t total = 0;
+    for (size_t i = 0; i < parts.size(); ++i) {
+        offsets[i] = total;
+        total += parts[i]->size();
+    }
+
+    out.resize(total);
+    if (total < PARALLEL_GATHER_MIN) {
+        for (size_t i = 0; i < parts.size(); ++i) {
+            std::copy(parts[i]->begin(), parts[i]->end(), out.begin() + offsets[i]);
+        }
+    } else {
+        pool.ParallelFor(static_cast<int>(parts.size()), 1, [&](int begin, int end, int) {
+            for (int i = begin; i < end; ++i) {
+                std::copy(parts[i]->begin(), parts[i]->end(), out.begin() + offsets[i]);
+            }
+        });
+    }
+
+    for (std::vector<int>* part : parts) part->clear();
+}
+
+DeltaStepping::DeltaStepping(const DeltaSteppingOptions& options)
+    : options(options), pool(options.threadCount), workers(pool.GetThreadCount()) {}
+
+float DeltaStepping::ChooseDelta(const CsrGraph& graph) {
+    int edgeCount = graph.EdgeCount();
+    if (edgeCount == 0) return 1.0f;
+
+    int stride = std::max(1, edgeCount / DELTA_SAMPLE_SIZE);
+    std::vector<float> sample;
+    for (int e = 0; e < edgeCount; e += stride) sample.push_back(graph.Weight(e));
+    std::sort(sample.begin(), sample.end());
+
+    // Meyer & Sanders' delta ~ 1 / degree for uniform weights, read off the
+    // actual weight distribution as a quantile.
+    double averageDegree = static_cast<double>(edgeCount) / graph.NodeCount();
+    double fraction = std::min(1.0, LIGHT_EDGES_PER_NODE / averageDegree);
+    size_t index = std::min(sample.size() - 1, static_cast<size_t>(fraction * sample.size()));
+
+    float delta = sample[index];
+    if (delta > 0.0f) return delta;
+
+    // Mostly zero weights: the smallest positive one still keeps those in
+    // the same bucket.
+    auto positive = std::upper_bound(sample.begin(), sample.end(), 0.0f);
+    return positive != sample.end() ? *positive : 1.0f;
+}
+
+void DeltaStepping::SplitEdges() {
+    if (splitBuildId == graph->GetBuildId() && splitDelta == delta &&
+        lightEnd.size() == static_cast<size_t>(graph->NodeCount())) {
+        return;
+    }
+
+    lightEnd.resize(graph->NodeCount());
+    targets.resize(graph->EdgeCount());
+    weights.resize(graph->EdgeCount());
+
+    maxWeight = 0.0f;
+    for (int e = 0; e < graph->EdgeCount(); ++e) maxWeight = std::max(maxWeight, graph->Weight(e));
+
+    pool.ParallelFor(graph->NodeCount(), FILL_GRAIN / 16, [&](int begin, int end, int) {
+        for (int u = begin; u < end; ++u) {
+            int out = graph->EdgesBegin(u);
+            for (int e = graph->EdgesBegin(u); e < graph->EdgesEnd(u); ++e) {
+                if (graph->Weight(e) > delta) continue;
+                targets[out] = graph->Target(e);
+                weights[out++] = graph->Weight(e);
+            }
+            lightEnd[u] = out;
+            for (int e = graph->EdgesBegin(u); e < graph->EdgesEnd(u); ++e) {
+                if (graph->Weight(e) <= delta) continue;
+                targets[out] = graph->Target(e);
+                weights[out++] = graph->Weight(e);
+            }
+        }
+    });
+
+    splitBuildId = graph->GetBuildId();
+    splitDelta = delta;
+}
+
+size_t DeltaStepping::BucketOf(float distance) const {
+    return static_cast<size_t>(std::min(static_cast<double>(distance) / delta, MAX_BUCKET));
+}
+
+void DeltaStepping::Begin(const CsrGraph& g, int source, int targetIndex) {
+    graph = &g;
+    target = targetIndex;
+    delta = options.delta > 0.0f ? options.delta : ChooseDelta(g);
+    SplitEdges();
+
+    if (nodeCount != g.NodeCount() || !state) {
+        nodeCount = g.NodeCount();
+        state.reset(new std::atomic<uint64_t>[nodeCount]);
+        expanded.reset(new std::atomic<uint32_t>[nodeCount]);
+        settled.reset(new std::atomic<uint32_t>[nodeCount]);
+        phaseSerial = UINT32_MAX;
+    }
+
+    // Stamps only ever need to differ from the previous phase or bucket;
+    // restart them long before the counters could wrap.
+    bool resetStamps = phaseSerial > UINT32_MAX / 2;
+    if (resetStamps) {
+        phaseSerial = 0;
+        bucketSerial = 0;
+    }
+
+    pool.ParallelFor(nodeCount, FILL_GRAIN, [&](int begin, int end, int) {
+        for (int u = begin; u < end; ++u) {
+            state[u].store(UNREACHED, std::memory_order_relaxed);
+            if (resetStamps) {
+                expanded[u].store(0, std::memory_order_relaxed);
+                settled[u].store(0, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    // One slot of slack for rounding in BucketOf.
+    double span = std::ceil(static_cast<double>(maxWeight) / delta) + 2.0;
+    ringSize = static_cast<size_t>(std::min(span, static_cast<double>(MAX_RING_SIZE)));
+
+    for (Worker& worker : workers) {
+        for (std::vector<int>& list : worker.buckets) list.clear();
+        worker.buckets.resize(ringSize);
+        worker.far.clear();
+        worker.settled.clear();
+    }
+    frontier.clear();
+    lastSettled.clear();
+    materialized = false;
+    bucketCount = 0;
+    settledCount = 0;
+    bucket = 0;
+
+    finished = source < 0 || source >= nodeCount;
+    if (finished) return;
+
+    state[source].store(Pack(0.0f, -1), std::memory_order_relaxed);
+    workers[0].buckets[0].push_back(source);
+}
+
+void DeltaStepping::Relax(Worker& worker, int u, float du, int begin, int end) {
+    // Nothing at least as far as the target's current distance can shorten
+    // its path.
+    float bound = target != -1 ? Distance(target) : INF_DISTANCE;
+
+    for (int e = begin; e < end; ++e) {
+        int v = targets[e];
+        float nd = du + weights[e];
+        if (nd >= bound) continue;
+
+        uint64_t desired = Pack(nd, u);
+        uint64_t current = state[v].load(std::memory_order_relaxed);
+        while ((desired >> 32) < (current >> 32)) {
+            if (state[v].compare_exchange_weak(current, desired, std::memory_order_relaxed)) {
+                size_t index = BucketOf(nd);
+                if (index < bucket + ringSize) {
+                    worker.buckets[index % ringSize].push_back(v);
+                } else {
+                    worker.far.push_back(v);
+                }
+                break;
+            }
+        }
+    }
+}
+
+void DeltaStepping::Gather(size_t index, std::vector<int>& out) {
+    std::vector<std::vector<int>*> parts;
+    for (Worker& worker : workers) parts.push_back(&worker.buckets[index % ringSize]);
+    Concatenate(pool, parts, out);
+}
+
+void DeltaStepping::ExpandFrontier(uint32_t phase, uint32_t bucketStamp) {
+    pool.ParallelFor(static_cast<int>(frontier.size()), RELAX_GRAIN, [&](int begin, int end, int w) {
+        Worker& worker = workers[w];
+        for (int i = begin; i < end; ++i) {
+            int u = frontier[i];
+            if (expanded[u].exchange(phase, std::memory_order_relaxed) == phase) continue;
+
+            // Stale entry: the node has since moved to a later bucket.
+            float du = Distance(u);
+            if (BucketOf(du) != bucket) continue;
+
+            if (settled[u].exchange(bucketStamp, std::memory_order_relaxed) != bucketStamp) {
+                worker.settled.push_back(u);
+            }
+            Relax(worker, u, du, graph->EdgesBegin(u), lightEnd[u]);
+        }
+    });
+}
+
+bool DeltaStepping::FindNextBucket() {
+    // Starts at the current bucket in case rounding filed a heavy edge into
+    // it; it is simply expanded again.
+    for (size_t b = bucket; b < bucket + ringSize; ++b) {
+        for (const Worker& worker : workers) {
+            if (!worker.buckets[b % ringSize].empty()) {
+                bucket = b;
+                return true;
+            }
+        }
+    }
+
+    // The ring is empty, so every node whose distance falls in it is
+    // settled: overflow entries there are stale. The rest restart the ring
+    // at the nearest one.
+    size_t ringEnd = bucket + ringSize;
+    size_t next = SIZE_MAX;
+    for (Worker& worker : workers) {
+        size_t kept = 0;
+        for (int v : worker.far) {
+            size_t index = BucketOf(Distance(v));
+            if (index < ringEnd) continue;
+            next = std::min(next, index);
+            worker.far[kept++] = v;
+        }
+        worker.far.resize(kept);
+    }
+    if (next == SIZE_MAX) return false;
+
+    bucket = next;
+    for (Worker& worker : workers) {
+        size_t kept = 0;
+        for (int v : worker.far) {
+            size_t index = BucketOf(Distance(v));
+            if (index < bucket + ringSize) {
+                worker.buckets[index % ringSize].push_back(v);
+            } else {
+                worker.far[kept++] = v;
+            }
+        }
+        worker.far.resize(kept);
+    }
+    return true;
+}
+
+bool DeltaStepping::Step() {
+    if (finished) {
+        lastSettled.clear();
+        return false;
+    }
+
+    uint32_t bucketStamp = ++bucketSerial;
+
+    // Light phases: whatever they file into this bucket is expanded again.
+    Gather(bucket, frontier);
+    while (!frontier.empty()) {
+        ExpandFrontier(++phaseSerial, bucketStamp);
+        Gather(bucket, frontier);
+    }
+
+    std::vector<std::vector<int>*> parts;
+    for (Worker& worker : workers) parts.push_back(&worker.settled);
+    Concatenate(pool, parts, lastSettled);
+
+    bucketCount++;
+    settledCount += static_cast<long long>(lastSettled.size());
+
+    if (target != -1) {
+        float targetDistance = Distance(target);
+        if (targetDistance != INF_DISTANCE && BucketOf(targetDistance) <= bucket) {
+            finished = true;
+            return false;
+        }
+    }
+
+    // Heavy edges always leave the bucket, so one pass is enough.
+    pool.ParallelFor(static_cast<int>(lastSettled.size()), RELAX_GRAIN, [&](int begin, int end, int w) {
+        for (int i = begin; i < end; ++i) {
+            int u = lastSettled[i];
+            Relax(workers[w], u, Distance(u), lightEnd[u], graph->EdgesEnd(u));
+        }
+    });
+
+    finished = !FindNextBucket();
+    return !finished;
+}
+
+void DeltaStepping::Run(const CsrGraph& g, int source, int targetIndex) {
+    Begin(g, source, targetIndex);
+    while (Step()) {}
+}
+
+float DeltaStepping::Distance(int u) const {
+    return DistanceOf(state[u].load(std::memory_order_relaxed));
+}
+
+int DeltaStepping::Parent(int u) const {
+    return ParentOf(state[u].load(std::memory_order_relaxed));
+}
+
+float DeltaStepping::GetSettledRadius() const {
+    if (!finished) return bucket * delta;
+
+    // Stopped at the target, or ran out of buckets.
+    if (target != -1 && Distance(target) != INF_DISTANCE) return Distance(target);
+    return INF_DISTANCE;
+}
+
+void DeltaStepping::Materialize() {
+    if (materialized) return;
+    distances.resize(nodeCount);
+    parents.resize(nodeCount);
+
+    pool.ParallelFor(nodeCount, FILL_GRAIN, [&](int begin, int end, int) {
+        for (int u = begin; u < end; ++u) {
+            uint64_t word = state[u].load(std::memory_order_relaxed);
+            distances[u] = DistanceOf(word);
+            parents[u] = ParentOf(word);
+        }
+    });
+    materialized = true;
+}
+
+const std::vector<float>& DeltaStepping::GetDistances() {
+    Materialize();
+    return distances;
+}
+
+const std::vector<int>& DeltaStepping::GetParents() {
+    Materialize();
+    return parents;
+}
@@ -0,0 +1,74 @@
+#include "../../include/algorithms/Algorithms.hpp"
+#include <algorithm>
+#include <cstdio>
+
+constexpr float INF_DISTANCE = std::numeric_limits<float>::infinity();
+
+void DeltaSteppingSolver::Initialize(const CsrGraph* g, int start, int end) {
+    csr = g;
+    startIndex = csr->ToDense(start);
+    endIndex = csr->ToDense(end);
+    if (ProvablyUnreachable(csr, startIndex, endIndex)) startIndex = -1;
+
+    reached.clear();
+    expandedCount = 0;
+    engine.Begin(*csr, startIndex, endIndex);
+    if (startIndex == -1) return;
+
+    Emit(SearchEventKind::START, startIndex);
+}
+
+SolverState DeltaSteppingSolver::Step() {
+    if (startIndex == -1) return SolverState::FINISHED_NO_PATH;
+
+    bool more = engine.Step();
+    for (int u : engine.GetLastSettled()) {
+        expandedCount++;
+        reached.push_back(u);
+        if (u != startIndex && u != endIndex) Emit(SearchEventKind::SETTLED, u);
+    }
+
+    if (more) return SolverState::RUNNING;
+    bool found = endIndex != -1 && engine.Distance(endIndex) != INF_DISTANCE;
+    return found ? SolverState::FINISHED_FOUND_PATH : SolverState::FINISHED_NO_PATH;
+}
+
+std::vector<int> DeltaSteppingSolver::GetPath() const {
+    std::vector<int> path;
+    if (startIndex == -1) return path;
+
+    int curr = endIndex;
+    while (curr != startIndex && curr != -1 && engine.Parent(curr) != -1) {
+        path.push_back(csr->ToNodeId(curr));
+        curr = engine.Parent(curr);
+    }
+    path.push_back(csr->ToNodeId(startIndex));
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+bool DeltaSteppingSolver::ExportTree(ShortestPathTree& tree) const {
+    if (startIndex == -1) return false;
+
+    tree.root = startIndex;
+    tree.dist.resize(csr->NodeCount());
+    tree.parent.resize(csr->NodeCount());
+    for (int u = 0; u < csr->NodeCount(); ++u) {
+        tree.dist[u] = engine.Distance(u);
+        tree.parent[u] = engine.Parent(u);
+    }
+    tree.settledRadius = engine.GetSettledRadius();
+    return true;
+}
+
+void DeltaSteppingSolver::DrawDebug(IDebugCanvas& canvas) {
+    for (int u : reached) {
+        Vector2 pos = csr->Position(u);
+
+        char buffer[16];
+        std::snprintf(buffer, sizeof(buffer), "%.1f", engine.Distance(u));
+
+        Vector2 textPos = { pos.x - 10, pos.y - 35 };
+        canvas.DrawLabel(buffer, textPos, 20, COLOR_TEXT);
+    }
+}
@@ -0,0 +1,185 @@
+#include "../../include/algorithms/DistanceMatrix.hpp"
+#include "../../include/core/DaryHeap.hpp"
+#include "../../include/core/ThreadPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+constexpr float INF_DISTANCE = std::numeric_limits<float>::infinity();
+
+static bool Fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+// Distinct dense nodes of `ids`, and for each the positions it occupies.
+struct NodeSet {
+    std::vector<int> nodes;
+    std::vector<std::vector<int>> positions;
+};
+
+static bool CollectNodes(const CsrGraph& graph, const std::vector<int>& ids, const char* what,
+                         std::vector<int>& slot, NodeSet& set, std::string* error) {
+    for (size_t i = 0; i < ids.size(); ++i) {
+        int u = graph.ToDense(ids[i]);
+        if (u == -1) return Fail(error, std::string("unknown ") + what + " node " + std::to_string(ids[i]));
+
+        if (slot[u] == -1) {
+            slot[u] = static_cast<int>(set.nodes.size());
+            set.nodes.push_back(u);
+            set.positions.emplace_back();
+        }
+        set.positions[slot[u]].push_back(static_cast<int>(i));
+    }
+    return true;
+}
+
+// Per-thread Dijkstra state, reused from one search to the next.
+struct MatrixSearch {
+    IndexedDaryHeap<float> heap;
+    std::vector<float> dist;
+    std::vector<int> parent;
+    std::vector<int> reached;
+    long long settledCount = 0;
+
+    // Settles nodes from `root` until every node with a goal slot is done.
+    void Run(const CsrGraph& graph, int root, const std::vector<int>& goalSlot, int goalCount) {
+        heap.Reset(graph.NodeCount());
+        if (dist.size() != static_cast<size_t>(graph.NodeCount())) {
+            dist.assign(graph.NodeCount(), INF_DISTANCE);
+            parent.assign(graph.NodeCount(), -1);
+        } else {
+            for (int u : reached) {
+                dist[u] = INF_DISTANCE;
+                parent[u] = -1;
+            }
+        }
+        reached.clear();
+
+        dist[root] = 0.0f;
+        reached.push_back(root);
+        heap.PushOrDecrease(root, 0.0f);
+
+        int remaining = goalCount;
+        while (!heap.Empty() && remaining > 0) {
+            int u = heap.Pop();
+            settledCount++;
+            if (goalSlot[u] != -1) remaining--;
+
+            for (int e = graph.EdgesBegin(u); e < graph.EdgesEnd(u); ++e) {
+                int v = graph.Target(e);
+                float nd = dist[u] + graph.Weight(e);
+                if (nd < dist[v]) {
+                    if (dist[v] == INF_DISTANCE) reached.push_back(v);
+                    dist[v] = nd;
+                    parent[v] = u;
+                    heap.PushOrDecrease(v, nd);
+                }
+            }
+        }
+    }
+};
+
+bool DistanceMatrix::Compute(const CsrGraph& graph, const std::vector<int>& sourceIds, const std::vector<int>& targetIds,
+                             const DistanceMatrixOptions& options, DistanceMatrixStats* stats, std::string* error) {
+    auto computeStart = std::chrono::steady_clock::now();
+    Clear();
+
+    const int n = graph.NodeCount();
+    std::vector<int> sourceSlot(n, -1);
+    std::vector<int> targetSlot(n, -1);
+    NodeSet sources, targets;
+    if (!CollectNodes(graph, sourceIds, "source", sourceSlot, sources, error) ||
+        !CollectNodes(graph, targetIds, "target", targetSlot, targets, error)) {
+        return false;
+    }
+
+    rowCount = static_cast<int>(sourceIds.size());
+    columnCount = static_cast<int>(targetIds.size());
+    distances.assign(static_cast<size_t>(rowCount) * columnCount, INF_DISTANCE);
+    if (options.storePaths) paths.assign(distances.size(), {});
+
+    // Searching backward, a node's parent is the next hop towards the root,
+    // so paths read forward from the goal.
+    bool backward = targets.nodes.size() < sources.nodes.size();
+    CsrGraph reverse;
+    if (backward) reverse.BuildReverse(graph);
+    const CsrGraph& searchGraph = backward ? reverse : graph;
+    const NodeSet& roots = backward ? targets : sources;
+    const NodeSet& goals = backward ? sources : targets;
+    const std::vector<int>& goalSlot = backward ? sourceSlot : targetSlot;
+
+    ThreadPool pool(options.threadCount);
+    std::vector<MatrixSearch> searches(pool.GetThreadCount());
+    std::vector<int> searchCounts(pool.GetThreadCount(), 0);
+    std::vector<long long> ruledOutCounts(pool.GetThreadCount(), 0);
+
+    pool.ParallelFor(static_cast<int>(roots.nodes.size()), 1, [&](int begin, int end, int worker) {
+        MatrixSearch& search = searches[worker];
+        std::vector<int> path;
+
+        for (int r = begin; r < end; ++r) {
+            // Reachability always asks about the forward graph.
+            int root = roots.nodes[r];
+            int goalCount = 0;
+            for (int goal : goals.nodes) {
+                if (backward ? graph.MayReach(goal, root) : graph.MayReach(root, goal)) goalCount++;
+            }
+            ruledOutCounts[worker] += static_cast<long long>(goals.nodes.size()) - goalCount;
+            if (goalCount == 0) continue;
+
+            search.Run(searchGraph, root, goalSlot, goalCount);
+            searchCounts[worker]++;
+
+            for (size_t g = 0; g < goals.nodes.size(); ++g) {
+                int goal = goals.nodes[g];
+                float d = search.dist[goal];
+                if (d == INF_DISTANCE) continue;
+
+                path.clear();
+                if (options.storePaths) {
+                    for (int u = goal; u != -1; u = search.parent[u]) path.push_back(graph.ToNodeId(u));
+                    if (!backward) std::reverse(path.begin(), path.end());
+                }
+
+                // Every root is searched by one thread only, so its cells are
+                // written by that thread alone.
+                for (int rootPos : roots.positions[r]) {
+                    for (int goalPos : goals.positions[g]) {
+                        size_t cell = backward ? static_cast<size_t>(goalPos) * columnCount + rootPos
+                                               : static_cast<size_t>(rootPos) * columnCount + goalPos;
+                        distances[cell] = d;
+                        if (options.storePaths) paths[cell] = path;
+                    }
+                }
+            }
+        }
+    });
+
+    if (stats) {
+        stats->searches = 0;
+        stats->backward = backward;
+        stats->ruledOutPairs = 0;
+        stats->settledCount = 0;
+        for (size_t w = 0; w < searches.size(); ++w) {
+            stats->searches += searchCounts[w];
+            stats->ruledOutPairs += ruledOutCounts[w];
+            stats->settledCount += searches[w].settledCount;
+        }
+        stats->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - computeStart).count();
+    }
+    return true;
+}
+
+void DistanceMatrix::Clear() {
+    rowCount = 0;
+    columnCount = 0;
+    distances.clear();
+    paths.clear();
+}
+
+const std::vector<int>& DistanceMatrix::Path(int row, int column) const {
+    static const std::vector<int> EMPTY_PATH;
+    if (paths.empty()) return EMPTY_PATH;
+    return paths[static_cast<size_t>(row) * columnCount + column];
+}
@@ -0,0 +1,193 @@
+#include "../../include/algorithms/Landmarks.hpp"
+#include "../../include/core/DaryHeap.hpp"
+#include "../../include/core/ThreadPool.hpp"
+#include <algorithm>
+#include <limits>
+#include <random>
+
+constexpr float INF_DISTANCE = std::numeric_limits<float>::infinity();
+
+// Full single-source Dijkstra. `parent` and `order` (nodes in the order
+// they were settled) are filled in when given.
+static void ShortestDistances(const CsrGraph& graph, int source, IndexedDaryHeap<float>& heap,
+                              std::vector<float>& dist, std::vector<int>* parent = nullptr,
+                              std::vector<int>* order = nullptr) {
+    dist.assign(graph.NodeCount(), INF_DISTANCE);
+    if (parent) parent->assign(graph.NodeCount(), -1);
+    if (order) order->clear();
+    heap.Reset(graph.NodeCount());
+
+    dist[source] = 0.0f;
+    heap.PushOrDecrease(source, 0.0f);
+
+    while (!heap.Empty()) {
+        int u = heap.Pop();
+        if (order) order->push_back(u);
+
+        for (int e = graph.EdgesBegin(u); e < graph.EdgesEnd(u); ++e) {
+            int v = graph.Target(e);
+            float nd = dist[u] + graph.Weight(e);
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                if (parent) (*parent)[v] = u;
+                heap.PushOrDecrease(v, nd);
+            }
+        }
+    }
+}
+
+// FARTHEST: the reached node whose nearest landmark is farthest away.
+// Nodes no landmark reaches are skipped; on graphs with many small
+// components they would soak up every landmark while bounding almost no
+// queries. Returns -1 if every reached node is a landmark.
+static int PickFarthest(const std::vector<float>& nearest, const std::vector<uint8_t>& isLandmark) {
+    int best = -1;
+    for (int u = 0; u < static_cast<int>(nearest.size()); ++u) {
+        if (isLandmark[u] || nearest[u] == INF_DISTANCE) continue;
+        if (best == -1 || nearest[u] > nearest[best]) best = u;
+    }
+    return best;
+}
+
+void LandmarkTable::Build(const CsrGraph& graph, const LandmarkOptions& options) {
+    Clear();
+
+    const int n = graph.NodeCount();
+    const int k = std::min(std::max(options.count, 1), n);
+    if (n == 0) return;
+
+    std::mt19937 rng(options.seed);
+    IndexedDaryHeap<float> heap;
+    std::vector<float> dist;
+    std::vector<int> parent, order;
+
+    // dist(L, u) per chosen landmark, column-wise while selecting.
+    std::vector<std::vector<float>> fromColumns;
+    std::vector<uint8_t> isLandmark(n, 0);
+    std::vector<float> nearest(n, INF_DISTANCE);
+
+    auto addLandmark = [&](int landmark) {
+        landmarks.push_back(landmark);
+        isLandmark[landmark] = 1;
+        ShortestDistances(graph, landmark, heap, dist);
+        for (int u = 0; u < n; ++u) nearest[u] = std::min(nearest[u], dist[u]);
+        fromColumns.push_back(dist);
+    };
+
+    if (options.strategy == LandmarkStrategy::FARTHEST) {
+        // Seed with the node farthest from a random root.
+        int root = static_cast<int>(rng() % n);
+        ShortestDistances(graph, root, heap, dist);
+        int first = root;
+        for (int u = 0; u < n; ++u) {
+            if (dist[u] != INF_DISTANCE && dist[u] > dist[first]) first = u;
+        }
+        addLandmark(first);
+
+        while (static_cast<int>(landmarks.size()) < k) {
+            int pick = PickFarthest(nearest, isLandmark);
+            if (pick == -1) break;
+            addLandmark(pick);
+        }
+    } else {
+        std::vector<float> size(n);
+        std::vector<uint8_t> holdsLandmark(n);
+        std::vector<int> childOffsets(n + 1), children(n);
+
+        while (static_cast<int>(landmarks.size()) < k) {
+            int root;
+            do {
+                root = static_cast<int>(rng() % n);
+            } while (isLandmark[root]);
+
+            ShortestDistances(graph, root, heap, dist, &parent, &order);
+
+            // A node's weight is how badly the current landmarks bound its
+            // distance from the root; a subtree's size sums them, and drops
+            // to zero if a landmark already sits inside.
+            for (int v : order) {
+                float bound = 0.0f;
+                for (const std::vector<float>& from : fromColumns) {
+                    bound = std::max(bound, from[v] - from[root]);
+                }
+                size[v] = std::max(dist[v] - bound, 0.0f);
+                holdsLandmark[v] = isLandmark[v];
+            }
+            for (auto it = order.rbegin(); it != order.rend(); ++it) {
+                int v = *it;
+                if (holdsLandmark[v]) size[v] = 0.0f;
+                int p = parent[v];
+                if (p == -1) continue;
+                size[p] += size[v];
+                holdsLandmark[p] |= holdsLandmark[v];
+            }
+
+            // Children lists of the tree, then descend along the heaviest.
+            std::fill(childOffsets.begin(), childOffsets.end(), 0);
+            for (int v : order) {
+                if (parent[v] != -1) childOffsets[parent[v] + 1]++;
+            }
+            for (int u = 0; u < n; ++u) childOffsets[u + 1] += childOffsets[u];
+            std::vector<int> fill(childOffsets.begin(), childOffsets.end() - 1);
+            for (int v : order) {
+                if (parent[v] != -1) children[fill[parent[v]]++] = v;
+            }
+
+            int pick = root;
+            for (;;) {
+                int heaviest = -1;
+                for (int c = childOffsets[pick]; c < childOffsets[pick + 1]; ++c) {
+                    int child = children[c];
+                    if (heaviest == -1 || size[child] > size[heaviest]) heaviest = child;
+                }
+                if (heaviest == -1 || size[heaviest] <= 0.0f) break;
+                pick = heaviest;
+            }
+
+            // Every subtree already held a landmark: fall back to the tree
+            // node farthest from the existing ones.
+            if (pick == root && !landmarks.empty()) {
+                int farthest = PickFarthest(nearest, isLandmark);
+                if (farthest != -1) pick = farthest;
+            }
+            addLandmark(pick);
+        }
+    }
+
+    // dist(u, L): Dijkstra from each landmark on the reversed graph, all
+    // landmarks at once.
+    const int chosen = static_cast<int>(landmarks.size());
+    CsrGraph reverse;
+    reverse.BuildReverse(graph);
+
+    ThreadPool pool(options.threadCount);
+    std::vector<std::vector<float>> toColumns(chosen);
+    std::vector<IndexedDaryHeap<float>> heaps(pool.GetThreadCount());
+    pool.ParallelFor(chosen, 1, [&](int begin, int end, int worker) {
+        for (int i = begin; i < end; ++i) ShortestDistances(reverse, landmarks[i], heaps[worker], toColumns[i]);
+    });
+
+    landmarkCount = chosen;
+    fromLandmark.resize(static_cast<size_t>(n) * chosen);
+    toLandmark.resize(static_cast<size_t>(n) * chosen);
+    pool.ParallelFor(n, 4096, [&](int begin, int end, int) {
+        for (int u = begin; u < end; ++u) {
+            for (int i = 0; i < chosen; ++i) {
+                fromLandmark[static_cast<size_t>(u) * chosen + i] = fromColumns[i][u];
+                toLandmark[static_cast<size_t>(u) * chosen + i] = toColumns[i][u];
+            }
+        }
+    });
+
+    nodeCount = n;
+    sourceBuildId = graph.GetBuildId();
+}
+
+void LandmarkTable::Clear() {
+    nodeCount = 0;
+    landmarkCount = 0;
+    sourceBuildId = 0;
+    landmarks.clear();
+    fromLandmark.clear();
+    toLandmark.clear();
+}
@@ -0,0 +1,214 @@
+#include "../../include/algorithms/Algorithms.hpp"
+#include <algorithm>
+#include <cstdio>
+
+constexpr float INF_DISTANCE = std::numeric_limits<float>::infinity();
+
+float LpaStarSolver::Heuristic(int u) const {
+    if (endIndex == -1) return 0.0f;
+    return Distance(csr->Position(u), csr->Position(endIndex));
+}
+
+LpaStarSolver::Key LpaStarSolver::KeyOf(int u) const {
+    float distance = std::min(g[u], rhs[u]);
+    return { distance + Heuristic(u), distance };
+}
+
+void LpaStarSolver::Initialize(const CsrGraph* graph, int start, int end) {
+    int newStart = graph->ToDense(start);
+    int previousEnd = endIndex;
+
+    // Dense indices only stay put along a snapshot's own history.
+    bool sameBuild = searchedBuildId != 0 && graph->GetBuildId() == searchedBuildId;
+    bool nextBuild = searchedBuildId != 0 && graph->GetPreviousBuildId() == searchedBuildId &&
+                     graph->NodeCount() >= static_cast<int>(rhs.size());
+
+    csr = graph;
+    endIndex = csr->ToDense(end);
+    searchedBuildId = csr->GetBuildId();
+    expandedCount = 0;
+    changeCount = 0;
+    repaired = newStart != -1 && newStart == startIndex && (sameBuild || nextBuild);
+
+    if (!repaired) {
+        Reset(newStart);
+        if (startIndex == -1) return;
+    } else {
+        if (nextBuild) {
+            Resize(csr->NodeCount());
+            ApplyChanges();
+        }
+        // h depends on the end node and on node positions, which a new
+        // build may have moved.
+        if (nextBuild || endIndex != previousEnd) {
+            heap.Rekey([this](int u) { return KeyOf(u); });
+        }
+    }
+
+    // Keeps the search for the next query, just skips this one.
+    unreachable = ProvablyUnreachable(csr, startIndex, endIndex);
+    if (unreachable) return;
+
+    Emit(SearchEventKind::START, startIndex);
+}
+
+void LpaStarSolver::Reset(int start) {
+    const int n = csr->NodeCount();
+    heap.Reset(n);
+    g.assign(n, INF_DISTANCE);
+    rhs.assign(n, INF_DISTANCE);
+    parent.assign(n, -1);
+    touched.assign(n, 0);
+    reached.clear();
+
+    startIndex = start;
+    if (startIndex == -1) return;
+
+    rhs[startIndex] = 0.0f;
+    touched[startIndex] = 1;
+    reached.push_back(startIndex);
+    Requeue(startIndex);
+}
+
+void LpaStarSolver::Resize(int nodeCount) {
+    // New nodes come last and start out unreached.
+    g.resize(nodeCount, INF_DISTANCE);
+    rhs.resize(nodeCount, INF_DISTANCE);
+    parent.resize(nodeCount, -1);
+    touched.resize(nodeCount, 0);
+    heap.Grow(nodeCount);
+}
+
+void LpaStarSolver::ApplyChanges() {
+    const std::vector<EdgeChange>& changes = csr->GetEdgeChanges();
+    changeCount = static_cast<int>(changes.size());
+
+    for (const EdgeChange& change : changes) {
+        int from = csr->ToDense(change.fromId);
+        int to = csr->ToDense(change.toId);
+        if (from == -1 || to == -1) continue;
+
+        // A cheaper edge can only lower rhs; a dearer one matters only if
+        // rhs came through it.
+        if (change.newWeight < change.oldWeight) {
+            Lower(to, g[from] + change.newWeight, from);
+        } else if (change.newWeight > change.oldWeight && parent[to] == from) {
+            Rederive(to);
+        }
+    }
+}
+
+void LpaStarSolver::Requeue(int u) {
+    if (g[u] != rhs[u]) heap.PushOrUpdate(u, KeyOf(u));
+    else heap.Remove(u);
+}
+
+void LpaStarSolver::Lower(int u, float value, int from) {
+    if (u == startIndex || !(value < rhs[u])) return;
+
+    bool wasQueued = heap.Contains(u);
+    rhs[u] = value;
+    parent[u] = from;
+    if (!touched[u]) {
+        touched[u] = 1;
+        reached.push_back(u);
+    }
+
+    Requeue(u);
+    if (heap.Contains(u) && u != endIndex) {
+        Emit(wasQueued ? SearchEventKind::RELAXED : SearchEventKind::DISCOVERED, u);
+    }
+}
+
+void LpaStarSolver::Rederive(int u) {
+    if (u == startIndex) return;
+
+    if (reverseSourceId != csr->GetBuildId()) {
+        reverse.BuildReverse(*csr);
+        reverseSourceId = csr->GetBuildId();
+    }
+
+    float best = INF_DISTANCE;
+    int from = -1;
+    for (int e = reverse.EdgesBegin(u); e < reverse.EdgesEnd(u); ++e) {
+        int p = reverse.Target(e);
+        float d = g[p] + reverse.Weight(e);
+        if (d < best) {
+            best = d;
+            from = p;
+        }
+    }
+
+    bool wasQueued = heap.Contains(u);
+    rhs[u] = best;
+    parent[u] = from;
+
+    Requeue(u);
+    if (!wasQueued && heap.Contains(u) && u != endIndex) Emit(SearchEventKind::DISCOVERED, u);
+}
+
+SolverState LpaStarSolver::Step() {
+    if (startIndex == -1 || unreachable) return SolverState::FINISHED_NO_PATH;
+
+    // Without an end node the whole reachable graph is made consistent.
+    bool endDone = endIndex != -1 && g[endIndex] == rhs[endIndex] &&
+                   !(heap.Empty() || heap.TopKey() < KeyOf(endIndex));
+    if (heap.Empty() || endDone) {
+        bool found = endIndex != -1 && g[endIndex] != INF_DISTANCE;
+        return found ? SolverState::FINISHED_FOUND_PATH : SolverState::FINISHED_NO_PATH;
+    }
+
+    int u = heap.Pop();
+    expandedCount++;
+
+    if (rhs[u] < g[u]) {
+        // Overconsistent: settles at rhs, exactly like an A* expansion.
+        g[u] = rhs[u];
+        if (u != startIndex && u != endIndex) Emit(SearchEventKind::SETTLED, u);
+
+        for (int e = csr->EdgesBegin(u); e < csr->EdgesEnd(u); ++e) {
+            Lower(csr->Target(e), g[u] + csr->Weight(e), u);
+        }
+    } else {
+        // Underconsistent: g was too low. Forget it; u and every child that
+        // took its rhs from u go back on the queue with what is left.
+        g[u] = INF_DISTANCE;
+        Requeue(u);
+        if (heap.Contains(u) && u != endIndex) Emit(SearchEventKind::DISCOVERED, u);
+
+        for (int e = csr->EdgesBegin(u); e < csr->EdgesEnd(u); ++e) {
+            int v = csr->Target(e);
+            if (parent[v] == u) Rederive(v);
+        }
+    }
+
+    return SolverState::RUNNING;
+}
+
+std::vector<int> LpaStarSolver::GetPath() const {
+    std::vector<int> path;
+    if (startIndex == -1 || unreachable || endIndex == -1 || g[endIndex] == INF_DISTANCE) return path;
+
+    // Parents of consistent nodes form a tree; the hop limit only guards
+    // against walking a stale cycle.
+    int curr = endIndex;
+    while (curr != -1 && static_cast<int>(path.size()) < csr->NodeCount()) {
+        path.push_back(csr->ToNodeId(curr));
+        if (curr == startIndex) break;
+        curr = parent[curr];
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+void LpaStarSolver::DrawDebug(IDebugCanvas& canvas) {
+    for (int u : reached) {
+        if (g[u] == INF_DISTANCE) continue;
+
+        char buffer[16];
+        std::snprintf(buffer, sizeof(buffer), "%.1f", g[u]);
+
+        Vector2 pos = csr->Position(u);
+        canvas.DrawLabel(buffer, { pos.x - 10, pos.y - 35 }, 20, COLOR_TEXT);
+    }
+}
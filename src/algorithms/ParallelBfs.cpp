@@ -0,0 +1,207 @@
+#include "../../include/algorithms/ParallelBfs.hpp"
+#include <algorithm>
+
+// Below this many nodes, merging the per-thread lists is not worth waking
+// the pool.
+constexpr size_t PARALLEL_GATHER_MIN = 1 << 14;
+
+constexpr int TOP_DOWN_GRAIN = 64;
+constexpr int BOTTOM_UP_GRAIN = 16;   // in 64-node words
+constexpr int FILL_GRAIN = 1 << 14;
+
+static bool TestBit(const std::atomic<uint64_t>* bits, int u) {
+    return (bits[u >> 6].load(std::memory_order_relaxed) >> (u & 63)) & 1;
+}
+
+ParallelBfs::ParallelBfs(const ParallelBfsOptions& options)
+    : options(options), pool(options.threadCount), workers(pool.GetThreadCount()) {}
+
+void ParallelBfs::Begin(const CsrGraph& g, int source, int targetIndex) {
+    graph = &g;
+    target = targetIndex;
+
+    if (graph->GetBuildId() != reverseSourceId) {
+        reverse.BuildReverse(*graph);
+        reverseSourceId = graph->GetBuildId();
+    }
+
+    if (nodeCount != graph->NodeCount() || !parent) {
+        nodeCount = graph->NodeCount();
+        wordCount = (nodeCount + 63) / 64;
+        parent.reset(new std::atomic<int>[nodeCount]);
+        frontierBits.reset(new std::atomic<uint64_t>[wordCount]);
+        nextBits.reset(new std::atomic<uint64_t>[wordCount]);
+        depth.resize(nodeCount);
+    }
+
+    pool.ParallelFor(nodeCount, FILL_GRAIN, [&](int begin, int end, int) {
+        for (int u = begin; u < end; ++u) {
+            parent[u].store(-1, std::memory_order_relaxed);
+            depth[u] = -1;
+        }
+    });
+
+    for (Worker& worker : workers) {
+        worker.next.clear();
+        worker.scout = 0;
+    }
+    frontier.clear();
+    materialized = false;
+    level = 0;
+    bottomUp = false;
+    bottomUpLevels = 0;
+    previousFrontierSize = 0;
+    exhausted = false;
+
+    finished = source < 0 || source >= nodeCount;
+    if (finished) return;
+
+    parent[source].store(source, std::memory_order_relaxed);
+    depth[source] = 0;
+    frontier.push_back(source);
+    scout = graph->EdgesEnd(source) - graph->EdgesBegin(source);
+    edgesToCheck = graph->EdgeCount();
+    finished = source == target;
+}
+
+void ParallelBfs::TopDownLevel() {
+    pool.ParallelFor(static_cast<int>(frontier.size()), TOP_DOWN_GRAIN, [&](int begin, int end, int w) {
+        Worker& worker = workers[w];
+        for (int i = begin; i < end; ++i) {
+            int u = frontier[i];
+            for (int e = graph->EdgesBegin(u); e < graph->EdgesEnd(u); ++e) {
+                int v = graph->Target(e);
+                int unvisited = -1;
+                if (parent[v].load(std::memory_order_relaxed) == -1 &&
+                    parent[v].compare_exchange_strong(unvisited, u, std::memory_order_relaxed)) {
+                    depth[v] = level + 1;
+                    worker.next.push_back(v);
+                    worker.scout += graph->EdgesEnd(v) - graph->EdgesBegin(v);
+                }
+            }
+        }
+    });
+}
+
+void ParallelBfs::BottomUpLevel() {
+    // Each chunk owns whole words of the bitmap, so the nodes it may visit
+    // and the bits it writes are its own.
+    pool.ParallelFor(wordCount, BOTTOM_UP_GRAIN, [&](int begin, int end, int w) {
+        Worker& worker = workers[w];
+        for (int word = begin; word < end; ++word) {
+            uint64_t bits = 0;
+            int last = std::min(nodeCount, (word + 1) * 64);
+            for (int v = word * 64; v < last; ++v) {
+                if (parent[v].load(std::memory_order_relaxed) != -1) continue;
+
+                for (int e = reverse.EdgesBegin(v); e < reverse.EdgesEnd(v); ++e) {
+                    int u = reverse.Target(e);
+                    if (!TestBit(frontierBits.get(), u)) continue;
+
+                    parent[v].store(u, std::memory_order_relaxed);
+                    depth[v] = level + 1;
+                    bits |= uint64_t(1) << (v & 63);
+                    worker.next.push_back(v);
+                    worker.scout += graph->EdgesEnd(v) - graph->EdgesBegin(v);
+                    break;
+                }
+            }
+            nextBits[word].store(bits, std::memory_order_relaxed);
+        }
+    });
+
+    std::swap(frontierBits, nextBits);
+    bottomUpLevels++;
+}
+
+void ParallelBfs::FillFrontierBits() {
+    pool.ParallelFor(wordCount, FILL_GRAIN, [&](int begin, int end, int) {
+        for (int word = begin; word < end; ++word) frontierBits[word].store(0, std::memory_order_relaxed);
+    });
+    pool.ParallelFor(static_cast<int>(frontier.size()), FILL_GRAIN, [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            int u = frontier[i];
+            frontierBits[u >> 6].fetch_or(uint64_t(1) << (u & 63), std::memory_order_relaxed);
+        }
+    });
+}
+
+void ParallelBfs::GatherNext() {
+    std::vector<size_t> offsets(workers.size());
+    size_t total = 0;
+    scout = 0;
+    for (size_t w = 0; w < workers.size(); ++w) {
+        offsets[w] = total;
+        total += workers[w].next.size();
+        scout += workers[w].scout;
+        workers[w].scout = 0;
+    }
+
+    frontier.resize(total);
+    auto copy = [&](int w) {
+        std::copy(workers[w].next.begin(), workers[w].next.end(), frontier.begin() + offsets[w]);
+        workers[w].next.clear();
+    };
+    if (total < PARALLEL_GATHER_MIN) {
+        for (size_t w = 0; w < workers.size(); ++w) copy(static_cast<int>(w));
+    } else {
+        pool.Run(copy);
+    }
+}
+
+bool ParallelBfs::Step() {
+    if (finished) {
+        frontier.clear();
+        return false;
+    }
+
+    // Beamer's switching rule: go bottom-up once the frontier's edges are a
+    // sizable share of what is left to explore, and come back when the
+    // frontier is both shrinking and small.
+    size_t frontierSize = frontier.size();
+    if (!bottomUp) {
+        if (scout > edgesToCheck / std::max(options.alpha, 1)) {
+            bottomUp = true;
+            FillFrontierBits();
+        }
+    } else if (frontierSize < previousFrontierSize &&
+               frontierSize < static_cast<size_t>(nodeCount / std::max(options.beta, 1))) {
+        bottomUp = false;
+    }
+
+    if (bottomUp) {
+        BottomUpLevel();
+    } else {
+        edgesToCheck -= scout;
+        TopDownLevel();
+    }
+
+    previousFrontierSize = frontierSize;
+    GatherNext();
+    level++;
+
+    exhausted = frontier.empty();
+    finished = exhausted || (target != -1 && parent[target].load(std::memory_order_relaxed) != -1);
+    return !finished;
+}
+
+void ParallelBfs::Run(const CsrGraph& g, int source, int targetIndex) {
+    Begin(g, source, targetIndex);
+    while (Step()) {}
+}
+
+int ParallelBfs::Parent(int u) const {
+    int p = parent[u].load(std::memory_order_relaxed);
+    return p == u ? -1 : p;
+}
+
+const std::vector<int>& ParallelBfs::GetParents() {
+    if (!materialized) {
+        parents.resize(nodeCount);
+        pool.ParallelFor(nodeCount, FILL_GRAIN, [&](int begin, int end, int) {
+            for (int u = begin; u < end; ++u) parents[u] = Parent(u);
+        });
+        materialized = true;
+    }
+    return parents;
+}
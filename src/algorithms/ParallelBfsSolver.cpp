@@ -0,0 +1,85 @@
+#include "../../include/algorithms/Algorithms.hpp"
+#include <algorithm>
+#include <cstdio>
+
+void ParallelBfsSolver::Initialize(const CsrGraph* g, int start, int end) {
+    csr = g;
+    startIndex = csr->ToDense(start);
+    endIndex = csr->ToDense(end);
+    if (ProvablyUnreachable(csr, startIndex, endIndex)) startIndex = -1;
+
+    frontier.clear();
+    reached.clear();
+    expandedCount = 0;
+    engine.Begin(*csr, startIndex, endIndex);
+    if (startIndex == -1) return;
+
+    frontier.push_back(startIndex);
+    reached.push_back(startIndex);
+    Emit(SearchEventKind::START, startIndex);
+}
+
+SolverState ParallelBfsSolver::Step() {
+    if (startIndex == -1) return SolverState::FINISHED_NO_PATH;
+    if (startIndex == endIndex) return SolverState::FINISHED_FOUND_PATH;
+
+    bool more = engine.Step();
+
+    for (int u : frontier) {
+        if (u != startIndex) Emit(SearchEventKind::SETTLED, u);
+    }
+    expandedCount += static_cast<int>(frontier.size());
+
+    frontier = engine.GetFrontier();
+    for (int u : frontier) {
+        reached.push_back(u);
+        if (u != endIndex) Emit(SearchEventKind::DISCOVERED, u);
+    }
+
+    if (more) return SolverState::RUNNING;
+    bool found = endIndex != -1 && engine.Depth(endIndex) != -1;
+    return found ? SolverState::FINISHED_FOUND_PATH : SolverState::FINISHED_NO_PATH;
+}
+
+std::vector<int> ParallelBfsSolver::GetPath() const {
+    std::vector<int> path;
+    if (startIndex == -1) return path;
+
+    int curr = endIndex;
+    while (curr != startIndex && curr != -1 && engine.Parent(curr) != -1) {
+        path.push_back(csr->ToNodeId(curr));
+        curr = engine.Parent(curr);
+    }
+    path.push_back(csr->ToNodeId(startIndex));
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+// Hop counts as distances.
+bool ParallelBfsSolver::ExportTree(ShortestPathTree& tree) const {
+    if (startIndex == -1) return false;
+
+    tree.root = startIndex;
+    tree.dist.resize(csr->NodeCount());
+    tree.parent.resize(csr->NodeCount());
+    for (int u = 0; u < csr->NodeCount(); ++u) {
+        int depth = engine.Depth(u);
+        tree.dist[u] = depth == -1 ? std::numeric_limits<float>::infinity() : static_cast<float>(depth);
+        tree.parent[u] = engine.Parent(u);
+    }
+    tree.settledRadius = engine.IsExhausted() ? std::numeric_limits<float>::infinity()
+                                              : static_cast<float>(engine.GetLevelCount());
+    return true;
+}
+
+void ParallelBfsSolver::DrawDebug(IDebugCanvas& canvas) {
+    for (int u : reached) {
+        Vector2 pos = csr->Position(u);
+
+        char buffer[16];
+        std::snprintf(buffer, sizeof(buffer), "%d", engine.Depth(u));
+
+        Vector2 textPos = { pos.x - 10, pos.y - 35 };
+        canvas.DrawLabel(buffer, textPos, 20, COLOR_TEXT);
+    }
+}
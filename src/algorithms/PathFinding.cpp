@@ -1,57 +1,92 @@
 #include "../../include/algorithms/Algorithms.hpp"
 #include <algorithm>
+#include <cmath>
 #include <cstdio>
 
-// BFS IMPLEMENTATIONS
+constexpr float INF_DISTANCE = std::numeric_limits<float>::infinity();
 
-void BfsSolver::Initialize(Graph* g, int start, int end) {
-    this->graph = g;
-    this->startNodeId = start;
-    this->endNodeId = end;
+// Walks parent links back from endIndex. Stops at the start, or at a node
+// without a parent if the end was never reached.
+static std::vector<int> TracePath(const CsrGraph* csr, const std::vector<int>& parent, int startIndex, int endIndex) {
+    std::vector<int> path;
+    if (startIndex == -1) return path;
 
-    frontier.clear();
-    visited.clear();
-    parentMap.clear();
+    int curr = endIndex;
+    while (curr != startIndex && curr != -1 && parent[curr] != -1) {
+        path.push_back(csr->ToNodeId(curr));
+        curr = parent[curr];
+    }
+    path.push_back(csr->ToNodeId(startIndex));
+    std::reverse(path.begin(), path.end());
+    return path;
+}
 
-    frontier.push_back(start);
-    visited.insert(start);
+static std::vector<int> TracePath(const CsrGraph* csr, const SolverWorkspace& workspace, int startIndex, int endIndex) {
+    std::vector<int> path;
+    if (startIndex == -1) return path;
 
-    if (Node* n = graph->GetNode(start)) {
-        n->color = ORANGE;
+    int curr = endIndex;
+    while (curr != startIndex && curr != -1 && workspace.Parent(curr) != -1) {
+        path.push_back(csr->ToNodeId(curr));
+        curr = workspace.Parent(curr);
     }
+    path.push_back(csr->ToNodeId(startIndex));
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+static void BeginQuery(SolverWorkspacePool::Lease& workspace, const CsrGraph* csr) {
+    if (!workspace) workspace = SolverWorkspacePool::Shared().Acquire();
+    workspace->Begin(csr->NodeCount());
+}
+
+// BFS IMPLEMENTATIONS
+
+void BfsSolver::Initialize(const CsrGraph* g, int start, int end) {
+    this->csr = g;
+    this->startIndex = csr->ToDense(start);
+    this->endIndex = csr->ToDense(end);
+    if (ProvablyUnreachable(csr, startIndex, endIndex)) startIndex = -1;
+
+    BeginQuery(workspace, csr);
+    head = 0;
+
+    expandedCount = 0;
+    if (startIndex == -1) return;
+
+    workspace->Touch(startIndex);
+    workspace->Reached().push_back(startIndex);
+
+    Emit(SearchEventKind::START, startIndex);
 }
 
 SolverState BfsSolver::Step() {
-    if (frontier.empty()) {
+    std::vector<int>& queue = workspace->Reached();
+    if (head == queue.size()) {
         return SolverState::FINISHED_NO_PATH;
     }
 
-    int currentId = frontier.front();
-    frontier.pop_front();
+    int currentId = queue[head++];
 
-    Node* currentNode = graph->GetNode(currentId);
+    expandedCount++;
 
-    if (currentId == endNodeId) {
+    if (currentId == endIndex) {
         return SolverState::FINISHED_FOUND_PATH;
     }
 
-    if (currentId != startNodeId) {
-        currentNode->color = RED;
+    if (currentId != startIndex) {
+        Emit(SearchEventKind::SETTLED, currentId);
     }
 
-    const std::vector<Edge>& neighbors = graph->GetNeighbors(currentId);
-
-    for (const Edge& edge : neighbors) {
-        int neighborId = edge.targetNodeId;
+    for (int e = csr->EdgesBegin(currentId); e < csr->EdgesEnd(currentId); ++e) {
+        int neighborId = csr->Target(e);
 
-        if (visited.find(neighborId) == visited.end()) {
-            visited.insert(neighborId);
-            parentMap[neighborId] = currentId;
-            frontier.push_back(neighborId);
+        if (!workspace->Contains(neighborId)) {
+            workspace->Touch(neighborId).parent = currentId;
+            queue.push_back(neighborId);
 
-            Node* neighborNode = graph->GetNode(neighborId);
-            if (neighborId != endNodeId) {
-                neighborNode->color = YELLOW;
+            if (neighborId != endIndex) {
+                Emit(SearchEventKind::DISCOVERED, neighborId);
             }
         }
     }
@@ -60,20 +95,7 @@ SolverState BfsSolver::Step() {
 }
 
 std::vector<int> BfsSolver::GetPath() const {
-    std::vector<int> path;
-
-    int current = endNodeId;
-
-    while (current != startNodeId && parentMap.count(current)) {
-        path.push_back(current);
-        current = parentMap.at(current);
-    }
-
-    path.push_back(startNodeId);
-
-    std::reverse(path.begin(), path.end());
-
-    return path;
+    return TracePath(csr, *workspace, startIndex, endIndex);
 }
 
 
@@ -81,24 +103,25 @@ std::vector<int> BfsSolver::GetPath() const {
 
 // START OF DFS
 
-void DfsSolver::Initialize(Graph* g, int start, int end) {
-    this->graph = g;
-    this->startNodeId = start;
-    this->endNodeId = end;
+void DfsSolver::Initialize(const CsrGraph* g, int start, int end) {
+    this->csr = g;
+    this->startIndex = csr->ToDense(start);
+    this->endIndex = csr->ToDense(end);
+    if (ProvablyUnreachable(csr, startIndex, endIndex)) startIndex = -1;
 
-    stack.clear();
-    visited.clear();
-    parentMap.clear();
+    BeginQuery(workspace, csr);
 
-    stack.push_back(start);
-    visited.insert(start);
+    expandedCount = 0;
+    if (startIndex == -1) return;
 
-    if (Node* n = graph->GetNode(start)) {
-        n->color = ORANGE;
-    }
+    workspace->Stack().push_back(startIndex);
+    workspace->Touch(startIndex);
+
+    Emit(SearchEventKind::START, startIndex);
 }
 
 SolverState DfsSolver::Step() {
+    std::vector<int>& stack = workspace->Stack();
     if (stack.empty()) {
         return SolverState::FINISHED_NO_PATH;
     }
@@ -106,30 +129,25 @@ SolverState DfsSolver::Step() {
     int currentId = stack.back();
     stack.pop_back();
 
-    Node* currentNode = graph->GetNode(currentId);
+    expandedCount++;
 
-    if (currentId == endNodeId) {
+    if (currentId == endIndex) {
         return SolverState::FINISHED_FOUND_PATH;
     }
 
-    if (currentId != startNodeId) {
-        currentNode->color = RED;
+    if (currentId != startIndex) {
+        Emit(SearchEventKind::SETTLED, currentId);
     }
 
-    const std::vector<Edge>& neighbors = graph->GetNeighbors(currentId);
+    for (int e = csr->EdgesBegin(currentId); e < csr->EdgesEnd(currentId); ++e) {
+        int neighbordId = csr->Target(e);
 
-    for (const Edge& edge : neighbors) {
-        int neighbordId = edge.targetNodeId;
-
-        if (visited.find(neighbordId) == visited.end()) {
-            visited.insert(neighbordId);
-            parentMap[neighbordId] = currentId;
+        if (!workspace->Contains(neighbordId)) {
+            workspace->Touch(neighbordId).parent = currentId;
             stack.push_back(neighbordId);
 
-            Node* neighbordNode = graph->GetNode(neighbordId);
-
-            if (neighbordId != endNodeId) {
-                neighbordNode->color = YELLOW;
+            if (neighbordId != endIndex) {
+                Emit(SearchEventKind::DISCOVERED, neighbordId);
             }
         }
     }
@@ -138,83 +156,93 @@ SolverState DfsSolver::Step() {
 }
 
 std::vector<int> DfsSolver::GetPath() const {
-    std::vector<int> path;
-    int curr = endNodeId;
-    while (curr != startNodeId && parentMap.count(curr)) {
-        path.push_back(curr);
-        curr = parentMap.at(curr);
-    }
-    path.push_back(startNodeId);
-    std::reverse(path.begin(), path.end());
-    return path;
+    return TracePath(csr, *workspace, startIndex, endIndex);
 }
 
 // END OF DFS
 
 //START OF DIJKSTRA
 
-void DijkstraSolver::Initialize(Graph* g, int start, int end) {
-    this->graph = g;
-    this->startNodeId = start;
-    this->endNodeId = end;
+void DijkstraSolver::Initialize(const CsrGraph* g, int start, int end) {
+    this->csr = g;
+    this->startIndex = csr->ToDense(start);
+    this->endIndex = csr->ToDense(end);
+    if (ProvablyUnreachable(csr, startIndex, endIndex)) startIndex = -1;
 
     pq = {};
-    dist.clear();
-    parentMap.clear();
+    BeginQuery(workspace, csr);
+    settledRadius = 0.0f;
 
-    dist[start] = 0.0f;
-    pq.push({0.0f, start});
+    expandedCount = 0;
+    if (startIndex == -1) return;
 
-    if (Node* n = graph->GetNode(start)) {
-        n->color = ORANGE;
-    }
+    workspace->Touch(startIndex).dist = 0.0f;
+    workspace->Reached().push_back(startIndex);
+    if (queueKind == QueueKind::INDEXED_DARY) workspace->Heap().PushOrDecrease(startIndex, 0.0f);
+    else pq.push({0.0f, startIndex});
+
+    Emit(SearchEventKind::START, startIndex);
 }
 
 SolverState DijkstraSolver::Step() {
-    if (pq.empty()) {
-        return SolverState::FINISHED_NO_PATH;
-    }
+    float currentDist;
+    int currentId;
+
+    if (queueKind == QueueKind::INDEXED_DARY) {
+        IndexedDaryHeap<float>& heap = workspace->Heap();
+        if (heap.Empty()) {
+            settledRadius = INF_DISTANCE;
+            return SolverState::FINISHED_NO_PATH;
+        }
+        currentDist = heap.TopKey();
+        currentId = heap.Pop();
+    } else {
+        if (pq.empty()) {
+            settledRadius = INF_DISTANCE;
+            return SolverState::FINISHED_NO_PATH;
+        }
 
-    PQElement top = pq.top();
-    pq.pop();
+        PQElement top = pq.top();
+        pq.pop();
 
-    float currentDist = top.first;
-    int currentId = top.second;
+        currentDist = top.first;
+        currentId = top.second;
 
-    if (currentDist > dist[currentId]) {
-        return SolverState::RUNNING;
+        if (currentDist > workspace->Distance(currentId)) {
+            return SolverState::RUNNING;
+        }
     }
 
-    Node* currentNode = graph->GetNode(currentId);
+    settledRadius = currentDist;
+    expandedCount++;
 
-    if (currentId == endNodeId) {
+    if (currentId == endIndex) {
         return SolverState::FINISHED_FOUND_PATH;
     }
 
-    if (currentId != startNodeId) {
-        currentNode->color = RED;
+    if (currentId != startIndex) {
+        Emit(SearchEventKind::SETTLED, currentId);
     }
 
-    const std::vector<Edge>& neighbors = graph->GetNeighbors(currentId);
-
-    for (const Edge& edge : neighbors) {
-        int neighborId = edge.targetNodeId;
-        float weight = edge.weight;
+    for (int e = csr->EdgesBegin(currentId); e < csr->EdgesEnd(currentId); ++e) {
+        int neighborId = csr->Target(e);
+        float weight = csr->Weight(e);
 
         float newDist = currentDist + weight;
 
-        bool isFirstDiscovery = (dist.find(neighborId) == dist.end());
-        bool isBetterPath = isFirstDiscovery || (newDist < dist[neighborId]);
+        SolverWorkspace::NodeState& neighbor = workspace->Touch(neighborId);
+        if (newDist < neighbor.dist) {
+            bool isFirstDiscovery = (neighbor.dist == INF_DISTANCE);
+            if (isFirstDiscovery) workspace->Reached().push_back(neighborId);
 
-        if (isBetterPath) {
-            dist[neighborId] = newDist;
-            parentMap[neighborId] = currentId;
-            pq.push({newDist, neighborId});
+            neighbor.dist = newDist;
+            neighbor.parent = currentId;
 
-            Node* neighborNode = graph->GetNode(neighborId);
+            if (queueKind == QueueKind::INDEXED_DARY) workspace->Heap().PushOrDecrease(neighborId, newDist);
+            else pq.push({newDist, neighborId});
 
-            if (neighborId != endNodeId) {
-                neighborNode->color = YELLOW;
+            if (neighborId != endIndex) {
+                Emit(isFirstDiscovery ? SearchEventKind::DISCOVERED : SearchEventKind::RELAXED, neighborId);
             }
         }
     }
@@ -223,28 +251,35 @@ SolverState DijkstraSolver::Step() {
 }
 
 std::vector<int> DijkstraSolver::GetPath() const {
-    std::vector<int> path;
-    int curr = endNodeId;
-    while (curr != startNodeId && parentMap.count(curr)) {
-        path.push_back(curr);
-        curr = parentMap.at(curr);
+    return TracePath(csr, *workspace, startIndex, endIndex);
+}
+
+// Every node whose tentative distance is at most the last key taken off the
+// queue already has its final distance and parent.
+bool DijkstraSolver::ExportTree(ShortestPathTree& tree) const {
+    if (startIndex == -1) return false;
+
+    tree.root = startIndex;
+    tree.dist.assign(csr->NodeCount(), INF_DISTANCE);
+    tree.parent.assign(csr->NodeCount(), -1);
+    for (int u : workspace->Reached()) {
+        tree.dist[u] = workspace->Distance(u);
+        tree.parent[u] = workspace->Parent(u);
     }
-    path.push_back(startNodeId);
-    std::reverse(path.begin(), path.end());
-    return path;
+    tree.settledRadius = settledRadius;
+    return true;
 }
 
-void DijkstraSolver::DrawDebug(Font font) {
-    for (auto const& [id, d] : dist) {
-        Node* n = graph->GetNode(id);   
-        if (!n) continue;
+void DijkstraSolver::DrawDebug(IDebugCanvas& canvas) {
+    for (int u : workspace->Reached()) {
+        Vector2 pos = csr->Position(u);
 
         char buffer[16];
 
-        std::snprintf(buffer, sizeof(buffer), ".1f", d);
+        std::snprintf(buffer, sizeof(buffer), "%.1f", workspace->Distance(u));
 
-        Vector2 textPos = { n->position.x - 10, n->position.y - 35};
-        DrawTextEx(font, buffer, textPos, 20, 1, BLACK);
+        Vector2 textPos = { pos.x - 10, pos.y - 35};
+        canvas.DrawLabel(buffer, textPos, 20, COLOR_TEXT);
     }
 }
 
@@ -252,89 +287,123 @@ void DijkstraSolver::DrawDebug(Font font) {
 
 // START OF A*
 
-float AStarSolver::Heuristic(int nodeId) {
-    if (!graph) return 0.0f;
-
-    Node* a = graph->GetNode(nodeId);
-    Node* b = graph->GetNode(endNodeId);
-
-    if (!a || !b) return 0.0f;
+float AStarSolver::Heuristic(int u) const {
+    if (!csr || endIndex == -1) return 0.0f;
 
-    return Vector2Distance(a->position, b->position);
+    if (landmarks) return landmarks->LowerBound(u, endIndex);
+    return Distance(csr->Position(u), csr->Position(endIndex));
 }
 
-void AStarSolver::Initialize(Graph* g, int start, int end) {
-    graph = g;
-    startNodeId = start;
-    endNodeId = end;
+void AStarSolver::Initialize(const CsrGraph* g, int start, int end) {
+    csr = g;
+    startIndex = csr->ToDense(start);
+    endIndex = csr->ToDense(end);
+    if (ProvablyUnreachable(csr, startIndex, endIndex)) startIndex = -1;
+
+    landmarks = nullptr;
+    if (heuristicKind == HeuristicKind::LANDMARKS) {
+        if (sharedLandmarks && sharedLandmarks->Matches(*csr)) {
+            landmarks = sharedLandmarks;
+        } else {
+            if (!ownLandmarks.Matches(*csr)) ownLandmarks.Build(*csr);
+            landmarks = &ownLandmarks;
+        }
+    }
 
     pq = {};
-    gScore.clear();
-    fScore.clear();
-    parentMap.clear();
+    BeginQuery(workspace, csr);
 
-    gScore[start] = 0.0f;
-    fScore[start] = Heuristic(start);
+    expandedCount = 0;
+    if (startIndex == -1) return;
 
-    pq.push({fScore[start], start});
+    SolverWorkspace::NodeState& startState = workspace->Touch(startIndex);
+    startState.dist = 0.0f;
+    startState.score = Heuristic(startIndex);
+    workspace->Reached().push_back(startIndex);
 
-    if (Node* n = graph->GetNode(start)) {
-        n->color = ORANGE;
-    }
+    if (queueKind == QueueKind::INDEXED_DARY) workspace->Heap().PushOrDecrease(startIndex, startState.score);
+    else pq.push({startState.score, startIndex});
+
+    Emit(SearchEventKind::START, startIndex);
 }
 
 SolverState AStarSolver::Step() {
-    if (pq.empty()) {
-        return SolverState::FINISHED_NO_PATH;
-    }
+    int currentId;
 
-    PQElement top = pq.top();
-    pq.pop();
+    if (queueKind == QueueKind::INDEXED_DARY) {
+        IndexedDaryHeap<float>& heap = workspace->Heap();
+        if (heap.Empty()) {
+            return SolverState::FINISHED_NO_PATH;
+        }
+        currentId = heap.Pop();
+    } else {
+        if (pq.empty()) {
+            return SolverState::FINISHED_NO_PATH;
+        }
 
-    float currentF = top.first;
-    int currentId = top.second;
+        PQElement top = pq.top();
+        pq.pop();
 
-    if (currentF > fScore[currentId]) {
-        return SolverState::RUNNING;
+        float currentF = top.first;
+        currentId = top.second;
+
+        if (currentF > workspace->Score(currentId)) {
+            return SolverState::RUNNING;
+        }
     }
 
-    if (currentId == endNodeId) {
+    expandedCount++;
+
+    if (currentId == endIndex) {
         return SolverState::FINISHED_FOUND_PATH;
     }
 
-    Node* currentNode = graph->GetNode(currentId);
-    if (currentId != startNodeId) {
-        currentNode->color = RED;
+    if (currentId != startIndex) {
+        Emit(SearchEventKind::SETTLED, currentId);
     }
 
-    const std::vector<Edge>& neighbors = graph->GetNeighbors(currentId);
+    float currentG = workspace->Distance(currentId);
 
-    for (const Edge& edge : neighbors) {
-        int neighborId = edge.targetNodeId;
-        float weight = edge.weight;
+    const int edgesBegin = csr->EdgesBegin(currentId);
+    const int edgesEnd = csr->EdgesEnd(currentId);
 
-        float tentativeG = gScore[currentId] + weight;
+    // Straight-line estimates are cheap enough to compute for every
+    // neighbour in one vectorized pass. Landmark bounds take a lookup per
+    // landmark, so those stay limited to neighbours that improve.
+    const bool batched = !landmarks && endIndex != -1;
+    if (batched) {
+        neighborHeuristics.resize(edgesEnd - edgesBegin);
+        csr->DistancesTo(csr->TargetsData() + edgesBegin, edgesEnd - edgesBegin,
+                         csr->Position(endIndex), neighborHeuristics.data());
+    }
 
-        bool isBetter = false;
-        if (gScore.find(neighborId) == gScore.end()) {
-            isBetter = true;
-        } else if (tentativeG < gScore[neighborId]) {
-            isBetter = true;
-        }
+    for (int e = edgesBegin; e < edgesEnd; ++e) {
+        int neighborId = csr->Target(e);
+        float weight = csr->Weight(e);
 
-        if (isBetter) {
-            parentMap[neighborId] = currentId;
-            gScore[neighborId] = tentativeG;
+        float tentativeG = currentG + weight;
+
+        SolverWorkspace::NodeState& neighbor = workspace->Touch(neighborId);
+        if (tentativeG < neighbor.dist) {
+            // Landmarks can prove the end unreachable from here; queuing
+            // such nodes anyway would tie them all at an infinite key.
+            float h = batched ? neighborHeuristics[e - edgesBegin] : Heuristic(neighborId);
+            if (h == INF_DISTANCE) continue;
+
+            bool isFirstDiscovery = (neighbor.dist == INF_DISTANCE);
+            if (isFirstDiscovery) workspace->Reached().push_back(neighborId);
+
+            neighbor.parent = currentId;
+            neighbor.dist = tentativeG;
 
-            float h = Heuristic(neighborId);
             float f = tentativeG + h;
-            fScore[neighborId] = f;
+            neighbor.score = f;
 
-            pq.push({f, neighborId});
+            if (queueKind == QueueKind::INDEXED_DARY) workspace->Heap().PushOrDecrease(neighborId, f);
+            else pq.push({f, neighborId});
 
-            Node* neighborNode = graph->GetNode(neighborId);
-            if (neighborId != endNodeId) {
-                neighborNode->color = YELLOW;
+            if (neighborId != endIndex) {
+                Emit(isFirstDiscovery ? SearchEventKind::DISCOVERED : SearchEventKind::RELAXED, neighborId);
             }
         }
     }
@@ -343,42 +412,168 @@ SolverState AStarSolver::Step() {
 }
 
 std::vector<int> AStarSolver::GetPath() const {
-    std::vector<int> path;
-    int curr = endNodeId;
+    // Backtrack from End -> Start through the parent links
+    return TracePath(csr, *workspace, startIndex, endIndex);
+}
+
+void AStarSolver::DrawDebug(IDebugCanvas& canvas) {
+    for (int u : workspace->Reached()) {
+        float g = workspace->Distance(u);
+        float h = Heuristic(u);
+        float f = workspace->Score(u);
+
+        char textG[10], textH[10], textF[10];
+        std::snprintf(textG, 10, "g:%.0f", g);
+        std::snprintf(textH, 10, "h:%.0f", h);
+        std::snprintf(textF, 10, "F:%.0f", f);
 
-    // Backtrack from End -> Start using the parentMap
-    // Safety check: parentMap.count(curr) prevents infinite loops if path is broken
-    while (curr != startNodeId && parentMap.count(curr)) {
-        path.push_back(curr);
-        curr = parentMap.at(curr);
+        Vector2 pos = csr->Position(u);
+        canvas.DrawLabel(textF, {pos.x - 5, pos.y - 5}, 20, COLOR_TEXT);
+        canvas.DrawLabel(textG, {pos.x - 25, pos.y - 25}, 10, COLOR_TEXT_DIM);
+        canvas.DrawLabel(textH, {pos.x + 10, pos.y - 25}, 10, COLOR_TEXT_DIM);
     }
+}
 
-    path.push_back(startNodeId);
-    
-    // Reverse the vector to get Start -> End order
-    std::reverse(path.begin(), path.end());
-    
-    return path;
+// END OF AStar
+
+
+// START OF RADIX DIJKSTRA
+
+// Fixed-point resolution for quantized weights: the largest weight maps to
+// at most this many units.
+constexpr int QUANTIZATION_BITS = 20;
+constexpr uint64_t NO_DISTANCE = std::numeric_limits<uint64_t>::max();
+
+void RadixDijkstraSolver::PrepareWeights() {
+    preparedBuildId = csr->GetBuildId();
+    keyWeights.clear();
+
+    bool integral = true;
+    bool negative = false;
+    float maxWeight = 0.0f;
+    for (int e = 0; e < csr->EdgeCount(); ++e) {
+        float w = csr->Weight(e);
+        if (!(w >= 0.0f)) { negative = true; break; }
+        if (w != std::floor(w) || w > 16777216.0f) integral = false;
+        maxWeight = std::max(maxWeight, w);
+    }
+
+    if (negative || std::isinf(maxWeight) || (!integral && !allowQuantization)) {
+        mode = Mode::FALLBACK;
+        return;
+    }
+
+    if (integral) {
+        mode = Mode::EXACT;
+        quantum = 1.0f;
+    } else {
+        mode = Mode::QUANTIZED;
+        int exponent;
+        std::frexp(maxWeight, &exponent);   // maxWeight < 2^exponent
+        quantum = std::ldexp(1.0f, exponent - QUANTIZATION_BITS);
+    }
+
+    keyWeights.resize(csr->EdgeCount());
+    for (int e = 0; e < csr->EdgeCount(); ++e) {
+        keyWeights[e] = static_cast<uint32_t>(std::lround(csr->Weight(e) / quantum));
+    }
 }
 
-void AStarSolver::DrawDebug(Font font) {
-    for (auto const& [id, g] : gScore) {
-        Node* n = graph->GetNode(id);
-        if (!n) continue;
+void RadixDijkstraSolver::Initialize(const CsrGraph* g, int start, int end) {
+    csr = g;
+    if (csr->GetBuildId() != preparedBuildId) PrepareWeights();
 
-        float h = Heuristic(id);
-        float f = fScore[id];
+    if (mode == Mode::FALLBACK) {
+        fallback.SetObserver(observer);
+        fallback.Initialize(g, start, end);
+        return;
+    }
 
-        char textG[10], textH[10], textF[10];
-        std::snprintf(textG, 10, "g:%.0f", g);
-        std::snprintf(textG, 10, "h:%.0f", h);
-        std::snprintf(textG, 10, "F:%.0f", f);
+    startIndex = csr->ToDense(start);
+    endIndex = csr->ToDense(end);
+    if (ProvablyUnreachable(csr, startIndex, endIndex)) startIndex = -1;
+
+    heap.Clear();
+    dist.assign(csr->NodeCount(), NO_DISTANCE);
+    parent.assign(csr->NodeCount(), -1);
+    reached.clear();
+
+    expandedCount = 0;
+    if (startIndex == -1) return;
+
+    dist[startIndex] = 0;
+    reached.push_back(startIndex);
+    heap.Push(0, startIndex);
+
+    Emit(SearchEventKind::START, startIndex);
+}
+
+SolverState RadixDijkstraSolver::Step() {
+    if (mode == Mode::FALLBACK) return fallback.Step();
 
-        Vector2 pos = n->position;
-        DrawTextEx(font, textF, {pos.x - 5, pos.y - 5}, 20, 1, BLACK);
-        DrawTextEx(font, textG, {pos.x - 25, pos.y - 25}, 10, 1, DARKGRAY);
-        DrawTextEx(font, textH, {pos.x + 10, pos.y - 25}, 10, 1, DARKGRAY);
+    if (heap.Empty()) {
+        return SolverState::FINISHED_NO_PATH;
+    }
+
+    auto [currentDist, currentId] = heap.Pop();
+    if (currentDist > dist[currentId]) {
+        return SolverState::RUNNING;
+    }
+
+    expandedCount++;
+
+    if (currentId == endIndex) {
+        return SolverState::FINISHED_FOUND_PATH;
+    }
+
+    if (currentId != startIndex) {
+        Emit(SearchEventKind::SETTLED, currentId);
+    }
+
+    for (int e = csr->EdgesBegin(currentId); e < csr->EdgesEnd(currentId); ++e) {
+        int neighborId = csr->Target(e);
+        uint64_t newDist = currentDist + keyWeights[e];
+
+        if (newDist < dist[neighborId]) {
+            bool isFirstDiscovery = (dist[neighborId] == NO_DISTANCE);
+            if (isFirstDiscovery) reached.push_back(neighborId);
+
+            dist[neighborId] = newDist;
+            parent[neighborId] = currentId;
+            heap.Push(newDist, neighborId);
+
+            if (neighborId != endIndex) {
+                Emit(isFirstDiscovery ? SearchEventKind::DISCOVERED : SearchEventKind::RELAXED, neighborId);
+            }
+        }
     }
+
+    return SolverState::RUNNING;
 }
 
-// END OF AStar
+std::vector<int> RadixDijkstraSolver::GetPath() const {
+    if (mode == Mode::FALLBACK) return fallback.GetPath();
+    return TracePath(csr, parent, startIndex, endIndex);
+}
+
+int RadixDijkstraSolver::GetExpandedCount() const {
+    return mode == Mode::FALLBACK ? fallback.GetExpandedCount() : expandedCount;
+}
+
+void RadixDijkstraSolver::DrawDebug(IDebugCanvas& canvas) {
+    if (mode == Mode::FALLBACK) {
+        fallback.DrawDebug(canvas);
+        return;
+    }
+
+    for (int u : reached) {
+        Vector2 pos = csr->Position(u);
+
+        char buffer[16];
+        std::snprintf(buffer, sizeof(buffer), "%.1f", dist[u] * quantum);
+
+        canvas.DrawLabel(buffer, { pos.x - 10, pos.y - 35 }, 20, COLOR_TEXT);
+    }
+}
+
+// END OF RADIX DIJKSTRA
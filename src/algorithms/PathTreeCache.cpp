@@ -0,0 +1,61 @@
+#include "../../include/algorithms/PathTreeCache.hpp"
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+constexpr float INF_DISTANCE = std::numeric_limits<float>::infinity();
+
+size_t PathTreeCache::KeyHash::operator()(const Key& key) const {
+    size_t h = std::hash<std::string>()(key.algorithm);
+    h ^= std::hash<uint64_t>()(key.version) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h ^= std::hash<int>()(key.source) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    return h;
+}
+
+const ShortestPathTree* PathTreeCache::Find(const std::string& algorithm, int source, uint64_t version, int target) {
+    auto it = index.find({ algorithm, source, version });
+    if (it == index.end() || !it->second->tree.Covers(target)) {
+        missCount++;
+        return nullptr;
+    }
+
+    entries.splice(entries.begin(), entries, it->second);
+    hitCount++;
+    return &it->second->tree;
+}
+
+void PathTreeCache::Insert(const std::string& algorithm, int source, uint64_t version, ShortestPathTree&& tree) {
+    if (capacity == 0) return;
+
+    Key key{ algorithm, source, version };
+    auto it = index.find(key);
+    if (it != index.end()) {
+        it->second->tree = std::move(tree);
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+
+    entries.push_front({ key, std::move(tree) });
+    index[key] = entries.begin();
+
+    if (entries.size() > capacity) {
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+}
+
+void PathTreeCache::Clear() {
+    entries.clear();
+    index.clear();
+    hitCount = 0;
+    missCount = 0;
+}
+
+std::vector<int> PathTreeCache::TracePath(const CsrGraph& graph, const ShortestPathTree& tree, int target) {
+    std::vector<int> path;
+    if (!tree.Covers(target) || tree.dist[target] == INF_DISTANCE) return path;
+
+    for (int u = target; u != -1; u = tree.parent[u]) path.push_back(graph.ToNodeId(u));
+    std::reverse(path.begin(), path.end());
+    return path;
+}
@@ -0,0 +1,286 @@
+#include "../../include/algorithms/SearchTrace.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <sys/stat.h>
+
+constexpr char TRACE_FILE_MAGIC[8] = { 'T', 'G', 'V', 'T', 'R', 'A', 'C', 'E' };
+constexpr uint32_t TRACE_FILE_VERSION = 1;
+constexpr uint32_t TRACE_FILE_BYTE_ORDER = 0x01020304;
+
+struct TraceFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    int32_t nodeCount;
+    uint32_t reserved;
+    uint64_t eventCount;
+    uint64_t keyframeInterval;
+    uint64_t byteCount;
+    uint64_t keyframeCount;
+};
+
+static bool Fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+// out = a * b + c, or false if that overflows.
+static bool MulAdd(uint64_t a, uint64_t b, uint64_t c, uint64_t& out) {
+    const uint64_t max = std::numeric_limits<uint64_t>::max();
+    if (b != 0 && a > (max - c) / b) return false;
+    out = a * b + c;
+    return true;
+}
+
+static uint8_t MarkFor(SearchEventKind kind) {
+    if (kind == SearchEventKind::RELAXED) kind = SearchEventKind::DISCOVERED;
+    return static_cast<uint8_t>(kind) + 1;
+}
+
+// Decodes the event at `offset`, advancing it and `prevNode`. Returns false
+// on a truncated varint.
+static bool DecodeEvent(const std::vector<uint8_t>& bytes, uint64_t& offset, int& prevNode, SearchEventKind& kind) {
+    uint64_t value = 0;
+    int shift = 0;
+    for (;;) {
+        if (offset >= bytes.size() || shift > 63) return false;
+        uint8_t byte = bytes[offset++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) break;
+        shift += 7;
+    }
+
+    kind = static_cast<SearchEventKind>(value & 7);
+    uint64_t zigzag = value >> 3;
+    int64_t delta = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+    prevNode = static_cast<int>(prevNode + delta);
+    return true;
+}
+
+// SEARCH TRACE
+
+void SearchTrace::Begin(int count) {
+    Clear();
+    nodeCount = count;
+    keyframeInterval = std::max<uint64_t>(MIN_KEYFRAME_INTERVAL, count);
+    marks.assign(count, 0);
+
+    keyframes.push_back({ 0, 0, 0 });
+    snapshots.assign(count, 0);
+}
+
+void SearchTrace::Clear() {
+    nodeCount = 0;
+    eventCount = 0;
+    keyframeInterval = MIN_KEYFRAME_INTERVAL;
+    bytes.clear();
+    keyframes.clear();
+    snapshots.clear();
+    marks.clear();
+    prevNode = 0;
+}
+
+void SearchTrace::OnSearchEvent(SearchEvent event) {
+    int64_t delta = static_cast<int64_t>(event.node) - prevNode;
+    uint64_t zigzag = (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63);
+    uint64_t value = (zigzag << 3) | static_cast<uint64_t>(event.kind);
+
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(value));
+
+    prevNode = event.node;
+    marks[event.node] = MarkFor(event.kind);
+    eventCount++;
+
+    if (eventCount % keyframeInterval == 0) {
+        keyframes.push_back({ bytes.size(), prevNode, 0 });
+        snapshots.insert(snapshots.end(), marks.begin(), marks.end());
+    }
+}
+
+bool SearchTrace::Save(const std::string& path, std::string* error) const {
+    TraceFileHeader header = {};
+    std::memcpy(header.magic, TRACE_FILE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_FILE_VERSION;
+    header.byteOrder = TRACE_FILE_BYTE_ORDER;
+    header.nodeCount = nodeCount;
+    header.eventCount = eventCount;
+    header.keyframeInterval = keyframeInterval;
+    header.byteCount = bytes.size();
+    header.keyframeCount = keyframes.size();
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return Fail(error, "cannot create " + path);
+
+    auto write = [&](const void* data, size_t size) {
+        return size == 0 || std::fwrite(data, 1, size, file) == size;
+    };
+    bool ok = write(&header, sizeof(header)) &&
+              write(bytes.data(), bytes.size()) &&
+              write(keyframes.data(), keyframes.size() * sizeof(Keyframe)) &&
+              write(snapshots.data(), snapshots.size());
+
+    if (std::fclose(file) != 0) ok = false;
+    if (!ok) return Fail(error, "write failed: " + path);
+    return true;
+}
+
+bool SearchTrace::Load(const std::string& path, std::string* error) {
+    Clear();
+
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return Fail(error, "cannot open " + path);
+
+    auto read = [&](void* data, size_t size) {
+        return size == 0 || std::fread(data, 1, size, file) == size;
+    };
+
+    struct stat info;
+    uint64_t fileSize = 0;
+    if (fstat(fileno(file), &info) == 0) fileSize = static_cast<uint64_t>(info.st_size);
+
+    // The sections must add up to exactly the file size before anything is
+    // sized from the header, so a corrupt one cannot ask for huge buffers.
+    TraceFileHeader header;
+    uint64_t expectedSize = 0;
+    bool ok = read(&header, sizeof(header)) &&
+              std::memcmp(header.magic, TRACE_FILE_MAGIC, sizeof(header.magic)) == 0 &&
+              header.version == TRACE_FILE_VERSION &&
+              header.byteOrder == TRACE_FILE_BYTE_ORDER &&
+              header.nodeCount >= 0 &&
+              header.keyframeInterval > 0 &&
+              header.keyframeCount == header.eventCount / header.keyframeInterval + 1 &&
+              MulAdd(header.keyframeCount, header.nodeCount, sizeof(header), expectedSize) &&
+              MulAdd(header.keyframeCount, sizeof(Keyframe), expectedSize, expectedSize) &&
+              MulAdd(header.byteCount, 1, expectedSize, expectedSize) &&
+              expectedSize == fileSize;
+
+    if (ok) {
+        bytes.resize(header.byteCount);
+        keyframes.resize(header.keyframeCount);
+        snapshots.resize(header.keyframeCount * header.nodeCount);
+        ok = read(bytes.data(), bytes.size()) &&
+             read(keyframes.data(), keyframes.size() * sizeof(Keyframe)) &&
+             read(snapshots.data(), snapshots.size());
+    }
+    std::fclose(file);
+
+    if (!ok) {
+        Clear();
+        return Fail(error, path + ": not a trace file, or truncated");
+    }
+
+    nodeCount = header.nodeCount;
+    keyframeInterval = header.keyframeInterval;
+
+    // Decode everything once: checks the keyframes, snapshots and node
+    // indices so the player can trust them, and leaves the recorder state at
+    // the end. Recording always starts from keyframe {0, 0, 0}.
+    const uint8_t maxMark = MarkFor(SearchEventKind::BACKWARD_SETTLED);
+    const Keyframe& first = keyframes[0];
+    bool snapshotsOk = first.byteOffset == 0 && first.prevNode == 0 && first.reserved == 0 &&
+                       std::all_of(snapshots.begin(), snapshots.end(), [&](uint8_t mark) { return mark <= maxMark; });
+    if (!snapshotsOk) {
+        Clear();
+        return Fail(error, path + ": corrupt keyframe data");
+    }
+    marks.assign(snapshots.begin(), snapshots.begin() + nodeCount);
+    uint64_t offset = 0;
+    for (uint64_t i = 0; i < header.eventCount; ++i) {
+        SearchEventKind kind;
+        if (!DecodeEvent(bytes, offset, prevNode, kind) ||
+            prevNode < 0 || prevNode >= nodeCount || kind > SearchEventKind::BACKWARD_SETTLED) {
+            Clear();
+            return Fail(error, path + ": corrupt event data");
+        }
+        marks[prevNode] = MarkFor(kind);
+
+        if ((i + 1) % keyframeInterval == 0) {
+            uint64_t index = (i + 1) / keyframeInterval;
+            const Keyframe& keyframe = keyframes[index];
+            const uint8_t* snapshot = snapshots.data() + index * nodeCount;
+            if (keyframe.byteOffset != offset || keyframe.prevNode != prevNode ||
+                !std::equal(marks.begin(), marks.end(), snapshot)) {
+                Clear();
+                return Fail(error, path + ": keyframes do not match the events");
+            }
+        }
+    }
+    if (offset != bytes.size()) {
+        Clear();
+        return Fail(error, path + ": trailing event data");
+    }
+
+    eventCount = header.eventCount;
+    return true;
+}
+
+// TRACE PLAYER
+
+void TracePlayer::Attach(const SearchTrace& newTrace) {
+    trace = &newTrace;
+    marks.assign(trace->nodeCount, 0);
+    changed.clear();
+    LoadKeyframe(0);
+}
+
+void TracePlayer::Detach() {
+    trace = nullptr;
+    marks.clear();
+    changed.clear();
+    position = 0;
+    byteOffset = 0;
+    prevNode = 0;
+    fullRefresh = false;
+}
+
+void TracePlayer::LoadKeyframe(uint64_t index) {
+    const SearchTrace::Keyframe& keyframe = trace->keyframes[index];
+    const uint8_t* snapshot = trace->snapshots.data() + index * trace->nodeCount;
+
+    std::copy(snapshot, snapshot + trace->nodeCount, marks.begin());
+    position = index * trace->keyframeInterval;
+    byteOffset = keyframe.byteOffset;
+    prevNode = keyframe.prevNode;
+
+    changed.clear();
+    fullRefresh = true;
+}
+
+void TracePlayer::DecodeUntil(uint64_t target) {
+    while (position < target) {
+        SearchEventKind kind;
+        if (!DecodeEvent(trace->bytes, byteOffset, prevNode, kind)) break;
+        marks[prevNode] = MarkFor(kind);
+        if (!fullRefresh) changed.push_back(prevNode);
+        position++;
+    }
+}
+
+void TracePlayer::Seek(uint64_t eventIndex) {
+    if (!trace) return;
+
+    uint64_t target = std::min(eventIndex, trace->eventCount);
+    uint64_t interval = trace->keyframeInterval;
+
+    // Decoding forward is cheaper than a keyframe copy until it would pass
+    // a keyframe anyway.
+    bool forwardInReach = target >= position && target - position < interval;
+    if (!forwardInReach) {
+        LoadKeyframe(std::min<uint64_t>(target / interval, trace->keyframes.size() - 1));
+    }
+    DecodeUntil(target);
+}
+
+void TracePlayer::Skip(int64_t delta) {
+    if (delta < 0 && static_cast<uint64_t>(-delta) > position) {
+        Seek(0);
+    } else {
+        Seek(position + delta);
+    }
+}
@@ -0,0 +1,27 @@
+#include "../../include/algorithms/SolverRegistry.hpp"
+#include "../../include/algorithms/Algorithms.hpp"
+
+std::unique_ptr<ISolver> CreateSolver(const std::string& name) {
+    if (name == "bfs")      return std::make_unique<BfsSolver>();
+    if (name == "bfs-parallel") return std::make_unique<ParallelBfsSolver>();
+    if (name == "dfs")      return std::make_unique<DfsSolver>();
+    if (name == "dijkstra") return std::make_unique<DijkstraSolver>();
+    if (name == "astar")    return std::make_unique<AStarSolver>();
+    if (name == "astar-alt") return std::make_unique<AStarSolver>(QueueKind::INDEXED_DARY, HeuristicKind::LANDMARKS);
+    if (name == "radix")    return std::make_unique<RadixDijkstraSolver>();
+    if (name == "radix-quantized") return std::make_unique<RadixDijkstraSolver>(true);
+    if (name == "bidijkstra") return std::make_unique<BidirectionalDijkstraSolver>();
+    if (name == "biastar")    return std::make_unique<BidirectionalAStarSolver>();
+    if (name == "ch")         return std::make_unique<ChSolver>();
+    if (name == "delta")      return std::make_unique<DeltaSteppingSolver>();
+    if (name == "lpastar")    return std::make_unique<LpaStarSolver>();
+
+    // Lazy-deletion binary heap, kept for comparison in the benchmarks.
+    if (name == "dijkstra-lazy") return std::make_unique<DijkstraSolver>(QueueKind::LAZY_BINARY);
+    if (name == "astar-lazy")    return std::make_unique<AStarSolver>(QueueKind::LAZY_BINARY);
+    return nullptr;
+}
+
+std::vector<std::string> GetSolverNames() {
+    return { "bfs", "bfs-parallel", "dfs", "dijkstra", "astar", "astar-alt", "radix", "radix-quantized", "bidijkstra", "biastar", "ch", "delta", "lpastar", "dijkstra-lazy", "astar-lazy" };
+}
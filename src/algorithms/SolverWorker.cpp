@@ -0,0 +1,145 @@
+#include "../../include/algorithms/SolverWorker.hpp"
+#include <chrono>
+#include <cmath>
+
+// Steps between clock reads for time-limited quotas.
+constexpr long long CLOCK_CHECK_INTERVAL = 32;
+
+SolverWorker::SolverWorker() {
+    thread = std::thread(&SolverWorker::Run, this);
+}
+
+SolverWorker::~SolverWorker() {
+    Cancel();
+    {
+        std::lock_guard<std::mutex> lock(commandMutex);
+        quit = true;
+    }
+    wake.notify_one();
+    thread.join();
+}
+
+void SolverWorker::Start(ISolver& newSolver, const CsrGraph& graph, int start, int end) {
+    Cancel();
+
+    {
+        std::lock_guard<std::mutex> lock(solverMutex);
+        solver = &newSolver;
+        csr = &graph;
+        startNodeId = start;
+        endNodeId = end;
+        solver->SetObserver(this);
+        state.store(SolverState::RUNNING, std::memory_order_release);
+    }
+    {
+        std::lock_guard<std::mutex> lock(commandMutex);
+        initPending = true;
+    }
+    wake.notify_one();
+}
+
+void SolverWorker::Grant(const StepQuota& quota) {
+    {
+        std::lock_guard<std::mutex> lock(commandMutex);
+        pendingQuota = quota;
+        quotaPending = true;
+    }
+    interrupted.store(false, std::memory_order_relaxed);
+    wake.notify_one();
+}
+
+void SolverWorker::Interrupt() {
+    interrupted.store(true, std::memory_order_relaxed);
+}
+
+void SolverWorker::Cancel() {
+    // The worker checks the generation after every Step and while waiting
+    // for ring space, so this lock is only held up by one Step at most.
+    generation.fetch_add(1, std::memory_order_acq_rel);
+    std::lock_guard<std::mutex> lock(solverMutex);
+
+    {
+        std::lock_guard<std::mutex> commandLock(commandMutex);
+        initPending = false;
+        quotaPending = false;
+    }
+
+    if (solver) solver->SetObserver(nullptr);
+    solver = nullptr;
+    csr = nullptr;
+    state.store(SolverState::NOT_STARTED, std::memory_order_release);
+    expandedCount.store(0, std::memory_order_relaxed);
+
+    events.ConsumeAll([](const SearchEvent&) {});
+}
+
+void SolverWorker::OnSearchEvent(SearchEvent event) {
+    uint64_t runGeneration = generation.load(std::memory_order_relaxed);
+    while (!events.TryPush(event)) {
+        if (generation.load(std::memory_order_relaxed) != runGeneration) return;
+        std::this_thread::yield();
+    }
+}
+
+void SolverWorker::Run() {
+    for (;;) {
+        bool doInit = false;
+        bool doQuota = false;
+        StepQuota quota;
+        uint64_t runGeneration = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(commandMutex);
+            wake.wait(lock, [this] { return quit || initPending || quotaPending; });
+            if (quit) return;
+
+            doInit = initPending;
+            doQuota = quotaPending;
+            quota = pendingQuota;
+            initPending = false;
+            quotaPending = false;
+            runGeneration = generation.load(std::memory_order_acquire);
+        }
+
+        std::lock_guard<std::mutex> lock(solverMutex);
+        if (!solver || generation.load(std::memory_order_acquire) != runGeneration) continue;
+
+        if (doInit) {
+            solver->Initialize(csr, startNodeId, endNodeId);
+        }
+        if (doQuota && state.load(std::memory_order_relaxed) == SolverState::RUNNING) {
+            RunQuota(quota, runGeneration);
+        }
+    }
+}
+
+void SolverWorker::RunQuota(const StepQuota& quota, uint64_t runGeneration) {
+    using Clock = std::chrono::steady_clock;
+
+    bool timed = std::isfinite(quota.milliseconds);
+    Clock::time_point deadline;
+    if (timed) {
+        deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<float, std::milli>(quota.milliseconds));
+    }
+
+    for (long long i = 0; i < quota.steps; ++i) {
+        if (generation.load(std::memory_order_relaxed) != runGeneration) return;
+        if (interrupted.load(std::memory_order_relaxed)) return;
+
+        SolverState result = solver->Step();
+        expandedCount.store(solver->GetExpandedCount(), std::memory_order_relaxed);
+
+        if (result != SolverState::RUNNING) {
+            if (result == SolverState::FINISHED_FOUND_PATH) {
+                for (int nodeId : solver->GetPath()) {
+                    OnSearchEvent({ csr->ToDense(nodeId), SearchEventKind::PATH });
+                }
+            }
+            state.store(result, std::memory_order_release);
+            return;
+        }
+
+        if (timed && (i + 1) % CLOCK_CHECK_INTERVAL == 0 && Clock::now() >= deadline) return;
+    }
+}
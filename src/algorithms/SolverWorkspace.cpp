@@ -0,0 +1,72 @@
+#include "../../include/algorithms/SolverWorkspace.hpp"
+#include <limits>
+
+constexpr float INF_DISTANCE = std::numeric_limits<float>::infinity();
+
+void SolverWorkspace::Begin(int nodeCount) {
+    if (nodes.size() < static_cast<size_t>(nodeCount)) {
+        nodes.resize(nodeCount, { 0, INF_DISTANCE, INF_DISTANCE, -1 });
+    }
+
+    // Stamp 0 is what fresh records carry, so epochs start at 1; on wrap
+    // every stamp is cleared once.
+    if (++epoch == 0) {
+        for (NodeState& node : nodes) node.stamp = 0;
+        epoch = 1;
+    }
+
+    heap.Reset(static_cast<int>(nodes.size()));
+    reached.clear();
+    stack.clear();
+}
+
+float SolverWorkspace::Distance(int u) const {
+    return Contains(u) ? nodes[u].dist : INF_DISTANCE;
+}
+
+float SolverWorkspace::Score(int u) const {
+    return Contains(u) ? nodes[u].score : INF_DISTANCE;
+}
+
+SolverWorkspace::NodeState SolverWorkspace::Unreached() const {
+    return { epoch, INF_DISTANCE, INF_DISTANCE, -1 };
+}
+
+void SolverWorkspacePool::Lease::Return() {
+    if (!workspace) return;
+    std::lock_guard<std::mutex> lock(pool->mutex);
+    pool->idle.push_back(std::move(workspace));
+}
+
+SolverWorkspacePool::Lease& SolverWorkspacePool::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        Return();
+        pool = other.pool;
+        workspace = std::move(other.workspace);
+    }
+    return *this;
+}
+
+SolverWorkspacePool::Lease SolverWorkspacePool::Acquire() {
+    Lease lease;
+    lease.pool = this;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (idle.empty()) {
+        lease.workspace = std::make_unique<SolverWorkspace>();
+    } else {
+        lease.workspace = std::move(idle.back());
+        idle.pop_back();
+    }
+    return lease;
+}
+
+size_t SolverWorkspacePool::GetIdleCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return idle.size();
+}
+
+SolverWorkspacePool& SolverWorkspacePool::Shared() {
+    static SolverWorkspacePool pool;
+    return pool;
+}
@@ -0,0 +1,323 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include "../../include/core/Graph.hpp"
+#include "../../include/core/Generators.hpp"
+#include "../../include/algorithms/Algorithms.hpp"
+#include "../../include/algorithms/SolverRegistry.hpp"
+
+// Solver benchmark over synthetic graphs. For every size (1k .. 10M nodes by
+// default) and graph family it builds the graph once, then runs the same
+// random start/end pairs through each solver and reports throughput, average
+// expansions and the process' peak resident memory so far.
+//
+// Every answer is also checked against Dijkstra's, outside the timed part:
+// all solvers must agree on whether a path exists, and the weighted ones on
+// its cost. Any mismatch is reported on stderr and fails the run.
+
+struct BenchOptions {
+    long long minNodes = 1000;
+    long long maxNodes = 10000000;
+    std::string family = "all";
+    std::string algo = "all";
+    int queries = 20;
+    double timeLimit = 5.0;
+    uint32_t seed = 42;
+    LandmarkOptions landmarks;
+};
+
+using Clock = std::chrono::steady_clock;
+
+// Contracting a scale-free graph is superlinear (its hubs keep every witness
+// search wide): about 30 s at 10k nodes and 4 min at 30k. Larger ones are
+// skipped rather than stalling the sweep.
+constexpr long long CH_SCALE_FREE_MAX_NODES = 10000;
+
+// Relative cost difference allowed for float sums taken in another order.
+constexpr float COST_EPSILON = 1e-4f;
+
+// radix-quantized rounds weights to steps of maxWeight / 2^20, so each edge
+// of its path or of the reference may add up to one step.
+constexpr float RADIX_QUANTIZATION_STEPS = 1 << 20;
+
+// Solvers that ignore weights: only whether they find a path is checked.
+static bool IsUnweighted(const std::string& name) {
+    return name == "bfs" || name == "bfs-parallel" || name == "dfs";
+}
+
+// Sum of edge weights along the path, taking the cheapest parallel edge;
+// infinity if two consecutive nodes are not joined by an edge.
+static float PathCost(const CsrGraph& csr, const std::vector<int>& path) {
+    float cost = 0.0f;
+    for (size_t i = 1; i < path.size(); ++i) {
+        int u = csr.ToDense(path[i - 1]);
+        int v = csr.ToDense(path[i]);
+        if (u < 0 || v < 0) return std::numeric_limits<float>::infinity();
+
+        float best = std::numeric_limits<float>::infinity();
+        for (int e = csr.EdgesBegin(u); e < csr.EdgesEnd(u); ++e) {
+            if (csr.Target(e) == v && csr.Weight(e) < best) best = csr.Weight(e);
+        }
+        cost += best;
+    }
+    return cost;
+}
+
+static double Seconds(Clock::time_point since) {
+    return std::chrono::duration<double>(Clock::now() - since).count();
+}
+
+// Peak RSS of the whole process in MiB. The OS only tracks the high-water
+// mark, so sizes run small -> large to keep the number meaningful per row.
+static double PeakMemoryMiB() {
+#if defined(__APPLE__)
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / (1024.0 * 1024.0);
+#elif defined(__unix__)
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;
+#else
+    return 0.0;
+#endif
+}
+
+static void PrintUsage() {
+    std::fprintf(stderr,
+        "Usage: GraphBench [options]\n"
+        "\n"
+        "  --min-nodes <n>     smallest graph size (default 1000)\n"
+        "  --max-nodes <n>     largest graph size (default 10000000)\n"
+        "  --family <name>     grid, geometric, scalefree or all (default all)\n"
+        "  --algo <name>       bfs, bfs-parallel, dfs, dijkstra, astar, astar-alt,\n"
+        "                      radix, radix-quantized, bidijkstra, biastar,\n"
+        "                      ch, delta, lpastar, dijkstra-lazy, astar-lazy or all (default all)\n"
+        "  --queries <n>       start/end pairs per graph (default 20)\n"
+        "  --time-limit <s>    stop a solver early after this many seconds per graph (default 5)\n"
+        "  --seed <n>          generator and query seed (default 42)\n"
+        "  --landmarks <n>     landmarks for astar-alt (default 16)\n"
+        "  --landmark-strategy <farthest|avoid>\n"
+        "                      landmark selection for astar-alt (default avoid)\n");
+}
+
+static bool ParseOptions(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--min-nodes" && hasValue)       options.minNodes = std::atoll(argv[++i]);
+        else if (arg == "--max-nodes" && hasValue)  options.maxNodes = std::atoll(argv[++i]);
+        else if (arg == "--family" && hasValue)     options.family = argv[++i];
+        else if (arg == "--algo" && hasValue)       options.algo = argv[++i];
+        else if (arg == "--queries" && hasValue)    options.queries = std::atoi(argv[++i]);
+        else if (arg == "--time-limit" && hasValue) options.timeLimit = std::atof(argv[++i]);
+        else if (arg == "--seed" && hasValue)       options.seed = static_cast<uint32_t>(std::atoll(argv[++i]));
+        else if (arg == "--landmarks" && hasValue)  options.landmarks.count = std::atoi(argv[++i]);
+        else if (arg == "--landmark-strategy" && hasValue && std::string(argv[i + 1]) == "farthest") {
+            options.landmarks.strategy = LandmarkStrategy::FARTHEST;
+            ++i;
+        } else if (arg == "--landmark-strategy" && hasValue && std::string(argv[i + 1]) == "avoid") {
+            options.landmarks.strategy = LandmarkStrategy::AVOID;
+            ++i;
+        } else {
+            PrintUsage();
+            return false;
+        }
+    }
+    return options.queries > 0 && options.landmarks.count > 0;
+}
+
+static bool BuildGraph(const std::string& family, long long nodeCount, uint32_t seed, Graph& graph) {
+    int n = static_cast<int>(nodeCount);
+    if (family == "grid") {
+        int side = static_cast<int>(std::sqrt(static_cast<double>(n)));
+        GenerateGrid(graph, side, (n + side - 1) / side);
+    } else if (family == "geometric") {
+        GenerateRandomGeometric(graph, n, 6.0f, seed);
+    } else if (family == "scalefree") {
+        GenerateScaleFree(graph, n, 3, seed);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options)) return 1;
+
+    std::vector<std::string> families = { "grid", "geometric", "scalefree" };
+    if (options.family != "all") families = { options.family };
+
+    std::vector<std::string> algos = GetSolverNames();
+    if (options.algo != "all") algos = { options.algo };
+    for (const std::string& name : algos) {
+        if (!CreateSolver(name)) {
+            std::fprintf(stderr, "Unknown algorithm '%s'\n", name.c_str());
+            return 1;
+        }
+    }
+
+    long long mismatches = 0;
+
+    std::printf("%-10s %9s %10s %-15s %7s %11s %10s %13s %6s %9s\n",
+        "family", "nodes", "edges", "algo", "queries", "queries/s", "avg_ms", "avg_expanded", "found", "peak_MiB");
+
+    for (long long size = 1000; size <= options.maxNodes; size *= 10) {
+        if (size < options.minNodes) continue;
+
+        for (const std::string& family : families) {
+            Graph graph;
+            auto buildStart = Clock::now();
+            if (!BuildGraph(family, size, options.seed, graph)) {
+                std::fprintf(stderr, "Unknown graph family '%s'\n", family.c_str());
+                return 1;
+            }
+            const CsrGraph& csr = graph.GetSnapshot();
+            std::printf("# %s %lld: built in %.2f s, peak %.0f MiB\n",
+                family.c_str(), size, Seconds(buildStart), PeakMemoryMiB());
+
+            // Same pairs for every solver. mt19937's output sequence is
+            // fixed by the standard, unlike the distributions.
+            std::mt19937 rng(options.seed);
+            std::vector<std::pair<int, int>> queries;
+            for (int q = 0; q < options.queries; ++q) {
+                int a = csr.ToNodeId(rng() % csr.NodeCount());
+                int b = csr.ToNodeId(rng() % csr.NodeCount());
+                queries.push_back({ a, b });
+            }
+
+            // Dijkstra's answer per query, computed when first needed.
+            struct Reference {
+                bool computed = false;
+                bool found = false;
+                float cost = 0.0f;
+                size_t hops = 0;
+            };
+            std::vector<Reference> references(queries.size());
+            DijkstraSolver referenceSolver;
+            auto reference = [&](size_t q) -> const Reference& {
+                Reference& ref = references[q];
+                if (!ref.computed) {
+                    referenceSolver.Initialize(&graph, queries[q].first, queries[q].second);
+                    SolverState state;
+                    do {
+                        state = referenceSolver.Step();
+                    } while (state == SolverState::RUNNING);
+                    ref.computed = true;
+                    ref.found = state == SolverState::FINISHED_FOUND_PATH;
+                    if (ref.found) {
+                        std::vector<int> path = referenceSolver.GetPath();
+                        ref.cost = PathCost(csr, path);
+                        ref.hops = path.size();
+                    }
+                }
+                return ref;
+            };
+
+            float maxWeight = 0.0f;
+            for (int e = 0; e < csr.EdgeCount(); ++e) maxWeight = std::max(maxWeight, csr.Weight(e));
+
+            for (const std::string& name : algos) {
+                if (name == "ch" && family == "scalefree" && size > CH_SCALE_FREE_MAX_NODES) {
+                    std::printf("# %s %lld: ch skipped, contraction is too slow on scale-free graphs this size\n",
+                        family.c_str(), size);
+                    continue;
+                }
+
+                std::unique_ptr<ISolver> solver = CreateSolver(name);
+
+                // Preprocessing is reported on its own, not folded into the
+                // first query.
+                ContractionHierarchy hierarchy;
+                LandmarkTable landmarks;
+                if (auto* ch = dynamic_cast<ChSolver*>(solver.get())) {
+                    ChBuildStats stats;
+                    hierarchy.Build(csr, ChBuildOptions(), &stats);
+                    ch->SetHierarchy(&hierarchy);
+                    std::printf("# %s %lld: contraction hierarchy in %.2f s, %d rounds, %llu shortcuts\n",
+                        family.c_str(), size, stats.seconds, stats.rounds,
+                        static_cast<unsigned long long>(stats.shortcutCount));
+                }
+                if (name == "astar-alt") {
+                    auto landmarkStart = Clock::now();
+                    landmarks.Build(csr, options.landmarks);
+                    static_cast<AStarSolver*>(solver.get())->SetLandmarks(&landmarks);
+                    std::printf("# %s %lld: %d landmarks in %.2f s\n",
+                        family.c_str(), size, landmarks.GetLandmarkCount(), Seconds(landmarkStart));
+                }
+
+                int done = 0;
+                int found = 0;
+                long long expanded = 0;
+                double elapsed = 0.0;
+                auto runStart = Clock::now();
+
+                for (size_t q = 0; q < queries.size(); ++q) {
+                    auto [start, end] = queries[q];
+                    auto queryStart = Clock::now();
+                    solver->Initialize(&graph, start, end);
+                    SolverState state;
+                    do {
+                        state = solver->Step();
+                    } while (state == SolverState::RUNNING);
+                    elapsed += Seconds(queryStart);
+
+                    done++;
+                    expanded += solver->GetExpandedCount();
+                    bool pathFound = state == SolverState::FINISHED_FOUND_PATH;
+                    if (pathFound) found++;
+
+                    const Reference& ref = reference(q);
+                    std::string problem;
+                    if (pathFound != ref.found) {
+                        problem = pathFound ? "found a path Dijkstra did not" : "found no path";
+                    } else if (pathFound && !IsUnweighted(name)) {
+                        std::vector<int> path = solver->GetPath();
+                        float cost = PathCost(csr, path);
+                        float slack = COST_EPSILON * std::max(1.0f, ref.cost);
+                        if (name == "radix-quantized") {
+                            slack += (path.size() + ref.hops) * maxWeight / RADIX_QUANTIZATION_STEPS;
+                        }
+                        bool valid = !path.empty() && path.front() == start && path.back() == end;
+                        if (!valid || !(std::fabs(cost - ref.cost) <= slack)) {
+                            problem = "cost " + std::to_string(cost) + ", expected " + std::to_string(ref.cost);
+                        }
+                    }
+                    if (!problem.empty()) {
+                        std::fprintf(stderr, "MISMATCH %s %lld %s: %d -> %d %s\n",
+                            family.c_str(), size, name.c_str(), start, end, problem.c_str());
+                        mismatches++;
+                    }
+
+                    if (Seconds(runStart) > options.timeLimit) break;
+                }
+
+                std::printf("%-10s %9d %10d %-15s %7d %11.1f %10.3f %13.0f %6d %9.0f\n",
+                    family.c_str(), csr.NodeCount(), csr.EdgeCount(), name.c_str(), done,
+                    done / elapsed, elapsed * 1e3 / done, static_cast<double>(expanded) / done,
+                    found, PeakMemoryMiB());
+                std::fflush(stdout);
+            }
+        }
+    }
+
+    if (mismatches > 0) {
+        std::fprintf(stderr, "%lld answers differ from Dijkstra's\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,461 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../../include/core/Graph.hpp"
+#include "../../include/core/GraphIO.hpp"
+#include "../../include/core/GraphFile.hpp"
+#include "../../include/core/GraphImporter.hpp"
+#include "../../include/core/ForceLayout.hpp"
+#include "../../include/algorithms/Algorithms.hpp"
+#include "../../include/algorithms/DistanceMatrix.hpp"
+#include "../../include/algorithms/SolverRegistry.hpp"
+
+// Headless batch runner: loads a graph, reads "<start> <end>" pairs and runs
+// every requested solver to completion, printing one tab-separated row per
+// (solver, query) followed by per-solver throughput totals.
+//
+// Queries and printed paths use the ids from the input files (e.g. DIMACS
+// 1..n), not the Graph's internal ids.
+
+struct Query {
+    long long start;
+    long long end;
+};
+
+struct SolverTotals {
+    std::string name;
+    double seconds = 0.0;
+    int queries = 0;
+    int found = 0;
+};
+
+static void PrintUsage() {
+    std::fprintf(stderr,
+        "Usage: GraphQuery <graph-file> [query-file|-] [options]\n"
+        "\n"
+        "Reads '<start> <end>' node id pairs (one per line) from query-file or stdin.\n"
+        "graph-file is a binary snapshot (.tgv), DIMACS (.gr), an edge list (.csv,\n"
+        ".edges, .el) or the text format from core/GraphIO.hpp (anything else).\n"
+        "Snapshots are memory-mapped and queried in place.\n"
+        "\n"
+        "Options:\n"
+        "  --algo <name>     bfs, bfs-parallel, dfs, dijkstra, astar, astar-alt,\n"
+        "                    radix, radix-quantized, bidijkstra, biastar,\n"
+        "                    ch, delta, lpastar, dijkstra-lazy, astar-lazy or all (default: all)\n"
+        "  --no-path         omit the node list from each result row\n"
+        "  --coords <file>   node coordinates for an imported graph (.co, .nodes, .xy)\n"
+        "  --directed        edge-list rows are one-way edges\n"
+        "  --scale <f>       multiply imported coordinates by f\n"
+        "  --flip-y          negate imported y coordinates (north up for lat/lon)\n"
+        "  --layout          replace the node positions with a force-directed layout\n"
+        "                    (run to convergence before anything else)\n"
+        "  --save <file>     write the loaded graph as a .tgv snapshot and continue\n"
+        "  --landmarks <n>   landmarks for astar-alt (default 16)\n"
+        "  --landmark-strategy <farthest|avoid>\n"
+        "                    landmark selection for astar-alt (default avoid)\n"
+        "  --tree-cache <n>  keep the last n shortest path trees (dijkstra, delta,\n"
+        "                    bfs-parallel) and answer repeated starts from them\n"
+        "  --matrix          instead of the pairs, print the distance from every start\n"
+        "                    to every end in one multithreaded batch (ignores --algo)\n"
+        "\n"
+        "ch preprocesses a contraction hierarchy before the first query. Snapshots\n"
+        "written by --save store it, and later runs on them load it instead.\n");
+}
+
+static bool HasExtension(const std::string& path, const char* ext) {
+    size_t len = std::char_traits<char>::length(ext);
+    return path.size() >= len && path.compare(path.size() - len, len, ext) == 0;
+}
+
+static bool ReadQueries(std::istream& in, std::vector<Query>& queries) {
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        lineNo++;
+
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.resize(comment);
+
+        std::istringstream fields(line);
+        Query q;
+        if (!(fields >> q.start)) continue;
+        if (!(fields >> q.end)) {
+            std::fprintf(stderr, "queries line %d: expected '<start> <end>'\n", lineNo);
+            return false;
+        }
+        queries.push_back(q);
+    }
+    return true;
+}
+
+// Sum of edge weights along the path, taking the cheapest parallel edge.
+static float PathCost(const CsrGraph& csr, const std::vector<int>& path) {
+    float cost = 0.0f;
+    for (size_t i = 1; i < path.size(); ++i) {
+        int u = csr.ToDense(path[i - 1]);
+        int v = csr.ToDense(path[i]);
+
+        float best = std::numeric_limits<float>::infinity();
+        for (int e = csr.EdgesBegin(u); e < csr.EdgesEnd(u); ++e) {
+            if (csr.Target(e) == v && csr.Weight(e) < best) best = csr.Weight(e);
+        }
+        cost += best;
+    }
+    return cost;
+}
+
+int main(int argc, char** argv) {
+    std::string graphPath;
+    std::string queryPath = "-";
+    std::string algo = "all";
+    std::string coordsPath;
+    std::string savePath;
+    bool printPath = true;
+    bool matrix = false;
+    bool layout = false;
+    int treeCacheSize = 0;
+    ImportOptions importOptions;
+    LandmarkOptions landmarkOptions;
+
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--algo" && i + 1 < argc) {
+            algo = argv[++i];
+        } else if (arg == "--no-path") {
+            printPath = false;
+        } else if (arg == "--matrix") {
+            matrix = true;
+        } else if (arg == "--tree-cache" && i + 1 < argc) {
+            treeCacheSize = std::max(std::atoi(argv[++i]), 0);
+        } else if (arg == "--coords" && i + 1 < argc) {
+            coordsPath = argv[++i];
+        } else if (arg == "--directed") {
+            importOptions.directed = true;
+        } else if (arg == "--scale" && i + 1 < argc) {
+            importOptions.coordinateScale = std::stof(argv[++i]);
+        } else if (arg == "--flip-y") {
+            importOptions.flipY = true;
+        } else if (arg == "--layout") {
+            layout = true;
+        } else if (arg == "--save" && i + 1 < argc) {
+            savePath = argv[++i];
+        } else if (arg == "--landmarks" && i + 1 < argc) {
+            landmarkOptions.count = std::max(std::atoi(argv[++i]), 1);
+        } else if (arg == "--landmark-strategy" && i + 1 < argc) {
+            std::string strategy = argv[++i];
+            if (strategy == "farthest") {
+                landmarkOptions.strategy = LandmarkStrategy::FARTHEST;
+            } else if (strategy == "avoid") {
+                landmarkOptions.strategy = LandmarkStrategy::AVOID;
+            } else {
+                std::fprintf(stderr, "Unknown landmark strategy '%s'\n", strategy.c_str());
+                return 1;
+            }
+        } else if (arg == "-h" || arg == "--help") {
+            PrintUsage();
+            return 0;
+        } else if (arg.size() > 1 && arg[0] == '-' && arg != "-") {
+            std::fprintf(stderr, "Unknown option '%s'\n", arg.c_str());
+            PrintUsage();
+            return 1;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+
+    if (positional.empty() || positional.size() > 2) {
+        PrintUsage();
+        return 1;
+    }
+    graphPath = positional[0];
+    if (positional.size() == 2) queryPath = positional[1];
+
+    std::vector<std::string> algoNames = (algo == "all") ? GetSolverNames() : std::vector<std::string>{ algo };
+    if (matrix) algoNames.clear();
+    for (const std::string& name : algoNames) {
+        if (!CreateSolver(name)) {
+            std::fprintf(stderr, "Unknown algorithm '%s'\n", name.c_str());
+            return 1;
+        }
+    }
+
+    Graph graph;
+    GraphImporter importer(graph, importOptions);
+    MappedGraphFile snapshot;
+    bool mapped = HasExtension(graphPath, ".tgv");
+    bool imported = !mapped && DetectImportFormat(graphPath) != ImportFormat::Auto;
+
+    if (!coordsPath.empty() && !imported) {
+        std::fprintf(stderr, "--coords needs an imported graph (.gr, .csv, .edges, .el)\n");
+        return 1;
+    }
+
+    if (layout && mapped) {
+        std::fprintf(stderr, "--layout: %s is a snapshot, load the graph it came from instead\n", graphPath.c_str());
+        return 1;
+    }
+
+    std::string error;
+    auto loadStart = std::chrono::steady_clock::now();
+    if (mapped) {
+        if (!snapshot.Open(graphPath, &error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    } else if (imported) {
+        if (!importer.Import(graphPath, ImportFormat::Auto, &error) ||
+            (!coordsPath.empty() && !importer.Import(coordsPath, ImportFormat::Auto, &error))) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    } else if (!LoadGraphText(graphPath, graph, &error)) {
+        std::fprintf(stderr, "%s: %s\n", graphPath.c_str(), error.c_str());
+        return 1;
+    }
+    const CsrGraph& csr = mapped ? snapshot.GetCsr() : graph.GetSnapshot();
+    double loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - loadStart).count();
+
+    if (layout) {
+        auto layoutStart = std::chrono::steady_clock::now();
+        ForceLayout engine;
+        int iterations = engine.Run(csr);
+        engine.Apply(graph);
+        graph.GetSnapshot();    // rebuilds csr with the new positions
+        std::printf("# layout: %d iterations over %d levels in %.3f s\n", iterations, engine.GetLevelCount(),
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - layoutStart).count());
+    }
+
+    // Snapshots of imported graphs carry the file's ids alongside the CSR.
+    uint64_t externalIdsSize = 0;
+    const long long* externalIds = static_cast<const long long*>(
+        snapshot.FindSection(SECTION_EXTERNAL_IDS, &externalIdsSize));
+    if (externalIdsSize != static_cast<uint64_t>(csr.NodeCount()) * sizeof(long long)) externalIds = nullptr;
+
+    std::unordered_map<long long, int> externalToNodeId;
+    if (externalIds) {
+        externalToNodeId.reserve(csr.NodeCount());
+        for (int u = 0; u < csr.NodeCount(); ++u) externalToNodeId[externalIds[u]] = csr.ToNodeId(u);
+    }
+
+    auto toNodeId = [&](long long externalId) -> int {
+        if (imported) return importer.FindNode(externalId);
+        if (externalIds) {
+            auto it = externalToNodeId.find(externalId);
+            return it != externalToNodeId.end() ? it->second : -1;
+        }
+        return (externalId >= 0 && externalId <= std::numeric_limits<int>::max()) ? static_cast<int>(externalId) : -1;
+    };
+    auto toExternalId = [&](int nodeId) -> long long {
+        if (imported) return importer.ToExternalId(nodeId);
+        if (externalIds) return externalIds[csr.ToDense(nodeId)];
+        return nodeId;
+    };
+
+    ContractionHierarchy hierarchy;
+    if (std::find(algoNames.begin(), algoNames.end(), "ch") != algoNames.end()) {
+        if (mapped && hierarchy.Attach(snapshot, &error)) {
+            std::printf("# contraction hierarchy: loaded from %s, %llu shortcuts\n",
+                graphPath.c_str(), static_cast<unsigned long long>(hierarchy.GetShortcutCount()));
+        } else {
+            if (mapped && snapshot.FindSection(SECTION_CH_INFO)) {
+                std::fprintf(stderr, "%s: %s, rebuilding\n", graphPath.c_str(), error.c_str());
+            }
+            ChBuildStats stats;
+            hierarchy.Build(csr, ChBuildOptions(), &stats);
+            std::printf("# contraction hierarchy: built in %.3f s, %d rounds, %llu shortcuts\n",
+                stats.seconds, stats.rounds, static_cast<unsigned long long>(stats.shortcutCount));
+        }
+    }
+
+    LandmarkTable landmarks;
+    if (std::find(algoNames.begin(), algoNames.end(), "astar-alt") != algoNames.end()) {
+        auto landmarkStart = std::chrono::steady_clock::now();
+        landmarks.Build(csr, landmarkOptions);
+        std::printf("# landmarks: %d in %.3f s\n", landmarks.GetLandmarkCount(),
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - landmarkStart).count());
+    }
+
+    if (!savePath.empty()) {
+        if (mapped) {
+            std::fprintf(stderr, "--save: %s is already a snapshot\n", graphPath.c_str());
+            return 1;
+        }
+
+        std::vector<long long> ids;
+        std::vector<GraphFileBlob> extras;
+        if (imported) {
+            ids.resize(csr.NodeCount());
+            for (int u = 0; u < csr.NodeCount(); ++u) ids[u] = importer.ToExternalId(csr.ToNodeId(u));
+            extras.push_back({ SECTION_EXTERNAL_IDS, ids.data(), ids.size() * sizeof(long long) });
+        }
+        for (const GraphFileBlob& section : hierarchy.GetSections()) extras.push_back(section);
+        if (!SaveGraphFile(savePath, graph, extras, &error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    }
+
+    std::vector<Query> queries;
+    if (queryPath == "-") {
+        if (!ReadQueries(std::cin, queries)) return 1;
+    } else {
+        std::ifstream in(queryPath);
+        if (!in) {
+            std::fprintf(stderr, "cannot open %s\n", queryPath.c_str());
+            return 1;
+        }
+        if (!ReadQueries(in, queries)) return 1;
+    }
+
+    std::printf("# graph %s: %d nodes, %d edges, loaded in %.3f s\n",
+        graphPath.c_str(), csr.NodeCount(), csr.EdgeCount(), loadSeconds);
+
+    if (matrix) {
+        // Distinct starts are the rows, distinct ends the columns.
+        std::vector<int> sourceIds, targetIds;
+        std::vector<long long> sourceExternal, targetExternal;
+        std::unordered_set<long long> seenSources, seenTargets;
+        for (const Query& q : queries) {
+            if (csr.ToDense(toNodeId(q.start)) == -1 || csr.ToDense(toNodeId(q.end)) == -1) {
+                std::fprintf(stderr, "skipping invalid query %lld %lld\n", q.start, q.end);
+                continue;
+            }
+            if (seenSources.insert(q.start).second) {
+                sourceIds.push_back(toNodeId(q.start));
+                sourceExternal.push_back(q.start);
+            }
+            if (seenTargets.insert(q.end).second) {
+                targetIds.push_back(toNodeId(q.end));
+                targetExternal.push_back(q.end);
+            }
+        }
+
+        DistanceMatrix distances;
+        DistanceMatrixOptions matrixOptions;
+        matrixOptions.storePaths = printPath;
+        DistanceMatrixStats stats;
+        if (!distances.Compute(csr, sourceIds, targetIds, matrixOptions, &stats, &error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+
+        std::printf("start\tend\tstatus\tcost%s\n", printPath ? "\tpath" : "");
+        for (int row = 0; row < distances.RowCount(); ++row) {
+            for (int column = 0; column < distances.ColumnCount(); ++column) {
+                float d = distances.Distance(row, column);
+                if (d == std::numeric_limits<float>::infinity()) {
+                    std::printf("%lld\t%lld\tno-path\t-%s\n", sourceExternal[row], targetExternal[column], printPath ? "\t" : "");
+                    continue;
+                }
+
+                std::printf("%lld\t%lld\tfound\t%.3f", sourceExternal[row], targetExternal[column], d);
+                if (printPath) {
+                    const std::vector<int>& path = distances.Path(row, column);
+                    std::printf("\t");
+                    for (size_t i = 0; i < path.size(); ++i) {
+                        std::printf(i ? " %lld" : "%lld", toExternalId(path[i]));
+                    }
+                }
+                std::printf("\n");
+            }
+        }
+        std::printf("# matrix: %d x %d, %d %s searches, %lld pairs ruled out, %lld nodes settled, %.3f ms\n",
+            distances.RowCount(), distances.ColumnCount(), stats.searches, stats.backward ? "backward" : "forward",
+            stats.ruledOutPairs, stats.settledCount, stats.seconds * 1e3);
+        return 0;
+    }
+
+    std::printf("algo\tstart\tend\tstatus\tcost\ttime_us%s\n", printPath ? "\tpath" : "");
+
+    // Snapshots have no Graph version; their build id changes just as often.
+    PathTreeCache treeCache(treeCacheSize);
+    uint64_t graphVersion = csr.GetBuildId();
+
+    std::vector<SolverTotals> totals;
+    for (const std::string& name : algoNames) {
+        std::unique_ptr<ISolver> solver = CreateSolver(name);
+        if (auto* ch = dynamic_cast<ChSolver*>(solver.get())) ch->SetHierarchy(&hierarchy);
+        if (auto* astar = dynamic_cast<AStarSolver*>(solver.get())) astar->SetLandmarks(&landmarks);
+
+        SolverTotals total;
+        total.name = name;
+
+        for (const Query& q : queries) {
+            int startId = toNodeId(q.start);
+            int endId = toNodeId(q.end);
+            if (csr.ToDense(startId) == -1 || csr.ToDense(endId) == -1) {
+                std::printf("%s\t%lld\t%lld\tinvalid\t-\t-%s\n", name.c_str(), q.start, q.end, printPath ? "\t" : "");
+                continue;
+            }
+
+            auto t0 = std::chrono::steady_clock::now();
+
+            SolverState state;
+            std::vector<int> path;
+            const ShortestPathTree* tree = treeCacheSize > 0 && solver->CanExportTree()
+                ? treeCache.Find(name, startId, graphVersion, csr.ToDense(endId)) : nullptr;
+            if (tree) {
+                path = PathTreeCache::TracePath(csr, *tree, csr.ToDense(endId));
+                state = path.empty() ? SolverState::FINISHED_NO_PATH : SolverState::FINISHED_FOUND_PATH;
+            } else {
+                solver->Initialize(&csr, startId, endId);
+                do {
+                    state = solver->Step();
+                } while (state == SolverState::RUNNING);
+
+                if (state == SolverState::FINISHED_FOUND_PATH) path = solver->GetPath();
+
+                ShortestPathTree grown;
+                if (treeCacheSize > 0 && solver->ExportTree(grown)) {
+                    treeCache.Insert(name, startId, graphVersion, std::move(grown));
+                }
+            }
+
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            total.seconds += seconds;
+            total.queries++;
+
+            if (state == SolverState::FINISHED_FOUND_PATH) {
+                total.found++;
+                std::printf("%s\t%lld\t%lld\tfound\t%.3f\t%.1f", name.c_str(), q.start, q.end,
+                    PathCost(csr, path), seconds * 1e6);
+            } else {
+                std::printf("%s\t%lld\t%lld\tno-path\t-\t%.1f", name.c_str(), q.start, q.end, seconds * 1e6);
+            }
+
+            if (printPath) {
+                std::printf("\t");
+                for (size_t i = 0; i < path.size(); ++i) {
+                    std::printf(i ? " %lld" : "%lld", toExternalId(path[i]));
+                }
+            }
+            std::printf("\n");
+        }
+
+        totals.push_back(total);
+    }
+
+    for (const SolverTotals& total : totals) {
+        double qps = total.seconds > 0.0 ? total.queries / total.seconds : 0.0;
+        std::printf("# %s: %d queries, %d found, %.3f ms total, %.0f queries/s\n",
+            total.name.c_str(), total.queries, total.found, total.seconds * 1e3, qps);
+    }
+    if (treeCacheSize > 0) {
+        std::printf("# tree cache: %llu hits, %llu misses\n",
+            static_cast<unsigned long long>(treeCache.GetHitCount()),
+            static_cast<unsigned long long>(treeCache.GetMissCount()));
+    }
+
+    return 0;
+}
@@ -0,0 +1,258 @@
+#include "../../include/core/CsrGraph.hpp"
+#include "../../include/core/Graph.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <numeric>
+
+// Nodes per gather-then-compute round of DistancesTo; sized to stay in
+// registers and L1.
+static constexpr int DISTANCE_BATCH = 64;
+
+static uint64_t NextBuildId() {
+    static std::atomic<uint64_t> counter{ 0 };
+    return ++counter;
+}
+
+void CsrGraph::Build(Graph& graph) {
+    Clear();
+
+    // Node ids are already dense, so both maps are the identity.
+    const NodeStore& nodes = graph.nodes;
+    const int n = nodes.Size();
+    int maxId = n - 1;
+    ownedNodeIds.resize(n);
+    std::iota(ownedNodeIds.begin(), ownedNodeIds.end(), 0);
+    ownedDenseIndex = ownedNodeIds;
+
+    const float* xs = nodes.X();
+    const float* ys = nodes.Y();
+    ownedPositions.resize(n);
+    for (int u = 0; u < n; ++u) ownedPositions[u] = { xs[u], ys[u] };
+    source = &graph;
+
+    size_t totalEdges = 0;
+    for (int u = 0; u < n; ++u) {
+        auto it = graph.adjacencyList.find(u);
+        if (it != graph.adjacencyList.end()) {
+            totalEdges += it->second.size();
+        }
+    }
+
+    ownedOffsets.resize(n + 1);
+    ownedTargets.reserve(totalEdges);
+    ownedWeights.reserve(totalEdges);
+
+    for (int u = 0; u < n; ++u) {
+        ownedOffsets[u] = static_cast<int>(ownedTargets.size());
+
+        auto it = graph.adjacencyList.find(ownedNodeIds[u]);
+        if (it == graph.adjacencyList.end()) continue;
+
+        for (const Edge& edge : it->second) {
+            ownedTargets.push_back(ownedDenseIndex[edge.targetNodeId]);
+            ownedWeights.push_back(edge.weight);
+        }
+    }
+    ownedOffsets[n] = static_cast<int>(ownedTargets.size());
+
+    buildId = NextBuildId();
+    nodeCount = n;
+    edgeCount = static_cast<int>(ownedTargets.size());
+    denseIndexSize = maxId + 1;
+    offsets = ownedOffsets.data();
+    targets = ownedTargets.data();
+    weights = ownedWeights.data();
+    nodeIds = ownedNodeIds.data();
+    denseIndex = ownedDenseIndex.data();
+    positions = ownedPositions.data();
+
+    componentIds.resize(n);
+    for (int u = 0; u < n; ++u) componentIds[u] = graph.FindComponent(ownedNodeIds[u]);
+    if (graph.GetOneWayEdgeCount() > 0) BuildSccs();
+}
+
+void CsrGraph::BuildConnectivity() {
+    // Union-find over the edges, as Graph does while they are added.
+    std::vector<int> parent(nodeCount);
+    for (int u = 0; u < nodeCount; ++u) parent[u] = u;
+    auto find = [&](int u) {
+        while (parent[u] != u) {
+            parent[u] = parent[parent[u]];
+            u = parent[u];
+        }
+        return u;
+    };
+
+    for (int u = 0; u < nodeCount; ++u) {
+        for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+            int a = find(u);
+            int b = find(targets[e]);
+            if (a != b) parent[std::max(a, b)] = std::min(a, b);
+        }
+    }
+
+    componentIds.resize(nodeCount);
+    for (int u = 0; u < nodeCount; ++u) componentIds[u] = find(u);
+    BuildSccs();
+}
+
+// Tarjan's algorithm with an explicit stack, since a long chain would
+// overflow the call stack. A component gets its number once everything it
+// reaches is numbered, so edges between components always lead to lower
+// numbers.
+void CsrGraph::BuildSccs() {
+    const int n = nodeCount;
+    sccIds.assign(n, -1);
+    std::vector<int> order(n, -1);   // discovery index
+    std::vector<int> low(n);
+    std::vector<int> open;           // Tarjan's stack: discovered, not yet numbered
+    std::vector<std::pair<int, int>> calls;   // (node, next edge)
+
+    int discovered = 0;
+    int sccCount = 0;
+    for (int root = 0; root < n; ++root) {
+        if (order[root] != -1) continue;
+
+        order[root] = low[root] = discovered++;
+        open.push_back(root);
+        calls.push_back({ root, offsets[root] });
+
+        while (!calls.empty()) {
+            int u = calls.back().first;
+            int e = calls.back().second;
+
+            if (e < offsets[u + 1]) {
+                calls.back().second++;
+                int v = targets[e];
+                if (order[v] == -1) {
+                    order[v] = low[v] = discovered++;
+                    open.push_back(v);
+                    calls.push_back({ v, offsets[v] });
+                } else if (sccIds[v] == -1) {
+                    low[u] = std::min(low[u], order[v]);
+                }
+                continue;
+            }
+
+            calls.pop_back();
+            if (!calls.empty()) {
+                int caller = calls.back().first;
+                low[caller] = std::min(low[caller], low[u]);
+            }
+
+            if (low[u] == order[u]) {
+                int w;
+                do {
+                    w = open.back();
+                    open.pop_back();
+                    sccIds[w] = sccCount;
+                } while (w != u);
+                sccCount++;
+            }
+        }
+    }
+}
+
+void CsrGraph::BuildReverse(const CsrGraph& forward) {
+    Clear();
+
+    const int n = forward.nodeCount;
+    const int m = forward.edgeCount;
+
+    // Counting sort of the edges by target.
+    ownedOffsets.assign(n + 1, 0);
+    for (int e = 0; e < m; ++e) ownedOffsets[forward.targets[e] + 1]++;
+    for (int u = 0; u < n; ++u) ownedOffsets[u + 1] += ownedOffsets[u];
+
+    ownedTargets.resize(m);
+    ownedWeights.resize(m);
+    std::vector<int> cursor(ownedOffsets.begin(), ownedOffsets.end() - 1);
+    for (int u = 0; u < n; ++u) {
+        for (int e = forward.offsets[u]; e < forward.offsets[u + 1]; ++e) {
+            int slot = cursor[forward.targets[e]]++;
+            ownedTargets[slot] = u;
+            ownedWeights[slot] = forward.weights[e];
+        }
+    }
+
+    buildId = NextBuildId();
+    nodeCount = n;
+    edgeCount = m;
+    denseIndexSize = forward.denseIndexSize;
+    offsets = ownedOffsets.data();
+    targets = ownedTargets.data();
+    weights = ownedWeights.data();
+    nodeIds = forward.nodeIds;
+    denseIndex = forward.denseIndex;
+    positions = forward.positions;
+}
+
+void CsrGraph::Attach(int nodeCount, int edgeCount,
+                      const int* offsets, const int* targets, const float* weights,
+                      const int* nodeIds, const int* denseIndex, int denseIndexSize,
+                      const Vector2* positions) {
+    Clear();
+
+    this->buildId = NextBuildId();
+    this->nodeCount = nodeCount;
+    this->edgeCount = edgeCount;
+    this->denseIndexSize = denseIndexSize;
+    this->offsets = offsets;
+    this->targets = targets;
+    this->weights = weights;
+    this->nodeIds = nodeIds;
+    this->denseIndex = denseIndex;
+    this->positions = positions;
+}
+
+void CsrGraph::SetHistory(uint64_t previous, std::vector<EdgeChange>&& changes) {
+    previousBuildId = previous;
+    edgeChanges = std::move(changes);
+}
+
+void CsrGraph::Clear() {
+    ownedOffsets.assign(1, 0);
+    ownedTargets.clear();
+    ownedWeights.clear();
+    ownedNodeIds.clear();
+    ownedDenseIndex.clear();
+    ownedPositions.clear();
+    source = nullptr;
+    previousBuildId = 0;
+    edgeChanges.clear();
+    componentIds.clear();
+    sccIds.clear();
+
+    buildId = NextBuildId();
+    nodeCount = 0;
+    edgeCount = 0;
+    denseIndexSize = 0;
+    offsets = ownedOffsets.data();
+    targets = nullptr;
+    weights = nullptr;
+    nodeIds = nullptr;
+    denseIndex = nullptr;
+    positions = nullptr;
+}
+
+void CsrGraph::SetColor(int u, Color color) const {
+    if (source) source->SetNodeColor(nodeIds[u], color);
+}
+
+void CsrGraph::DistancesTo(const int* nodes, int count, Vector2 to, float* out) const {
+    float dx[DISTANCE_BATCH];
+    float dy[DISTANCE_BATCH];
+
+    for (int first = 0; first < count; first += DISTANCE_BATCH) {
+        const int size = std::min(DISTANCE_BATCH, count - first);
+        for (int i = 0; i < size; ++i) {
+            Vector2 p = positions[nodes[first + i]];
+            dx[i] = p.x - to.x;
+            dy[i] = p.y - to.y;
+        }
+        for (int i = 0; i < size; ++i) {
+            out[first + i] = std::sqrt(dx[i] * dx[i] + dy[i] * dy[i]);
+        }
+    }
+}
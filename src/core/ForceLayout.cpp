@@ -0,0 +1,521 @@
+#include "../../include/core/ForceLayout.hpp"
+#include "../../include/core/Graph.hpp"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+// Hu's repulsion strength C, relative to the springs.
+constexpr float REPULSION = 0.2f;
+
+// Step length factor per adjustment, and how many improving iterations in a
+// row let it grow again.
+constexpr float STEP_DECAY = 0.9f;
+constexpr int STEP_PATIENCE = 5;
+
+// Coarsening stops at this many nodes, or once a round merges too few.
+constexpr int COARSEST_SIZE = 50;
+constexpr float COARSENING_RATIO = 0.75f;
+constexpr int MAX_LEVELS = 32;
+
+// K grows by sqrt(7/4) per coarser level (Walshaw), so a coarse layout comes
+// out about as large as the finer one it seeds.
+constexpr float COARSE_EDGE_FACTOR = 1.3228757f;
+
+// The coarsest level starts with steps this fraction of its extent.
+constexpr float HOT_START = 0.1f;
+
+// Fine nodes start this fraction of K away from their coarse node.
+constexpr float PROLONG_SPREAD = 0.1f;
+
+// Prime above any int, so k * SCRAMBLE % n visits every node once.
+constexpr uint64_t SCRAMBLE = 2654435761ull;
+
+// Morton codes hold this many bits per axis, which also caps the tree depth.
+constexpr int MORTON_BITS = 16;
+
+// Cells with this many nodes or fewer are not split further.
+constexpr int LEAF_SIZE = 8;
+
+// Enough for a depth-first walk of a MORTON_BITS-deep tree: each level
+// leaves at most three siblings behind.
+constexpr int WALK_STACK_SIZE = 4 * (MORTON_BITS + 2);
+
+// Closer than this, two nodes are pushed apart along an arbitrary direction.
+constexpr float MIN_DISTANCE = 0.01f;
+
+constexpr float GOLDEN_ANGLE = 2.399963229728653f;
+
+constexpr int FORCE_GRAIN = 256;
+constexpr int FILL_GRAIN = 1 << 14;
+
+// Spreads the low 16 bits of v to the even bit positions.
+static uint32_t SpreadBits(uint32_t v) {
+    v &= 0xffff;
+    v = (v | (v << 8)) & 0x00ff00ff;
+    v = (v | (v << 4)) & 0x0f0f0f0f;
+    v = (v | (v << 2)) & 0x33333333;
+    v = (v | (v << 1)) & 0x55555555;
+    return v;
+}
+
+static uint32_t GridCoordinate(float offset, float size) {
+    float cell = offset / size * (1 << MORTON_BITS);
+    return static_cast<uint32_t>(std::clamp(cell, 0.0f, static_cast<float>((1 << MORTON_BITS) - 1)));
+}
+
+static void Bounds(const std::vector<Vector2>& positions, Vector2& lo, Vector2& hi) {
+    lo = positions[0];
+    hi = lo;
+    for (const Vector2& p : positions) {
+        lo = { std::min(lo.x, p.x), std::min(lo.y, p.y) };
+        hi = { std::max(hi.x, p.x), std::max(hi.y, p.y) };
+    }
+}
+
+ForceLayout::ForceLayout(const ForceLayoutOptions& options)
+    : options(options), pool(options.threadCount), workerEnergy(pool.GetThreadCount()) {}
+
+void ForceLayout::Compact(Level& target, std::vector<int>& fill) {
+    const int n = target.NodeCount();
+
+    // fill[u] becomes the end of u's deduplicated list.
+    pool.ParallelFor(n, FILL_GRAIN / 16, [&](int begin, int end, int) {
+        for (int u = begin; u < end; ++u) {
+            auto first = target.neighbors.begin() + target.offsets[u];
+            std::sort(first, target.neighbors.begin() + fill[u]);
+            fill[u] = static_cast<int>(std::unique(first, target.neighbors.begin() + fill[u]) - target.neighbors.begin());
+        }
+    });
+
+    int out = 0;
+    for (int u = 0; u < n; ++u) {
+        int begin = target.offsets[u];
+        target.offsets[u] = out;
+        for (int i = begin; i < fill[u]; ++i) target.neighbors[out++] = target.neighbors[i];
+    }
+    target.offsets[n] = out;
+    target.neighbors.resize(out);
+}
+
+void ForceLayout::Begin(const CsrGraph& graph) {
+    const int n = graph.NodeCount();
+    levels.assign(1, Level());
+    Level& finest = levels[0];
+
+    nodeIds.resize(n);
+    finest.positions.resize(n);
+    for (int u = 0; u < n; ++u) {
+        nodeIds[u] = graph.ToNodeId(u);
+        finest.positions[u] = graph.Position(u);
+    }
+    finest.edgeLength = options.edgeLength;
+
+    // Both directions of every edge, then duplicates (parallel or
+    // two-way edges) and self-loops dropped.
+    finest.offsets.assign(n + 1, 0);
+    for (int u = 0; u < n; ++u) {
+        for (int e = graph.EdgesBegin(u); e < graph.EdgesEnd(u); ++e) {
+            int v = graph.Target(e);
+            if (v == u) continue;
+            finest.offsets[u + 1]++;
+            finest.offsets[v + 1]++;
+        }
+    }
+    for (int u = 0; u < n; ++u) finest.offsets[u + 1] += finest.offsets[u];
+
+    finest.neighbors.resize(finest.offsets[n]);
+    std::vector<int> fill(finest.offsets.begin(), finest.offsets.end() - 1);
+    for (int u = 0; u < n; ++u) {
+        for (int e = graph.EdgesBegin(u); e < graph.EdgesEnd(u); ++e) {
+            int v = graph.Target(e);
+            if (v == u) continue;
+            finest.neighbors[fill[u]++] = v;
+            finest.neighbors[fill[v]++] = u;
+        }
+    }
+    Compact(finest, fill);
+
+    // Nodes stacked in one spot (e.g. all at the origin) would all land in
+    // one leaf and be compared pairwise, so fan them out first.
+    if (n > 1) {
+        Vector2 lo, hi;
+        Bounds(finest.positions, lo, hi);
+        if (std::max(hi.x - lo.x, hi.y - lo.y) < options.edgeLength) {
+            Vector2 center = { (lo.x + hi.x) / 2.0f, (lo.y + hi.y) / 2.0f };
+            for (int u = 0; u < n; ++u) {
+                float r = 0.5f * options.edgeLength * std::sqrt(static_cast<float>(u));
+                finest.positions[u] = { center.x + r * std::cos(u * GOLDEN_ANGLE), center.y + r * std::sin(u * GOLDEN_ANGLE) };
+            }
+        }
+    }
+
+    while (Coarsen()) {}
+
+    iteration = 0;
+    projected.clear();
+    StartLevel(static_cast<int>(levels.size()) - 1);
+    finished = n < 2;
+}
+
+bool ForceLayout::Coarsen() {
+    const int n = levels.back().NodeCount();
+    if (n <= COARSEST_SIZE || static_cast<int>(levels.size()) >= MAX_LEVELS) return false;
+
+    std::vector<int> coarse(n, -1);
+    std::vector<int> groupSize;
+    {
+        const Level& fine = levels.back();
+        auto degree = [&](int v) { return fine.offsets[v + 1] - fine.offsets[v]; };
+
+        // Each node, in scrambled order, pairs up with its unmatched
+        // neighbour of least degree, so hubs do not take all the partners.
+        for (int k = 0; k < n; ++k) {
+            int u = static_cast<int>(static_cast<uint64_t>(k) * SCRAMBLE % n);
+            if (coarse[u] != -1) continue;
+
+            int partner = -1;
+            for (int i = fine.offsets[u]; i < fine.offsets[u + 1]; ++i) {
+                int v = fine.neighbors[i];
+                if (coarse[v] == -1 && v != u && (partner == -1 || degree(v) < degree(partner))) partner = v;
+            }
+            coarse[u] = static_cast<int>(groupSize.size());
+            if (partner != -1) coarse[partner] = coarse[u];
+            groupSize.push_back(partner != -1 ? 2 : 1);
+        }
+
+        // Nodes left alone because every neighbour was taken (the leaves of
+        // a star) join their smallest neighbouring group.
+        for (int u = 0; u < n; ++u) {
+            if (groupSize[coarse[u]] != 1) continue;
+            int best = -1;
+            for (int i = fine.offsets[u]; i < fine.offsets[u + 1]; ++i) {
+                int g = coarse[fine.neighbors[i]];
+                if (g != coarse[u] && (best == -1 || groupSize[g] < groupSize[best])) best = g;
+            }
+            if (best == -1) continue;
+            groupSize[coarse[u]] = 0;
+            coarse[u] = best;
+            groupSize[best]++;
+        }
+    }
+
+    // Renumber the groups that are left.
+    std::vector<int> renumber(groupSize.size(), -1);
+    int coarseCount = 0;
+    for (size_t g = 0; g < groupSize.size(); ++g) {
+        if (groupSize[g] > 0) renumber[g] = coarseCount++;
+    }
+    if (coarseCount > COARSENING_RATIO * n) return false;
+    for (int& g : coarse) g = renumber[g];
+
+    levels.emplace_back();
+    Level& fine = levels[levels.size() - 2];
+    Level& next = levels.back();
+    fine.coarse = std::move(coarse);
+    next.edgeLength = fine.edgeLength * COARSE_EDGE_FACTOR;
+
+    next.positions.assign(coarseCount, { 0.0f, 0.0f });
+    std::vector<int> members(coarseCount, 0);
+    for (int u = 0; u < n; ++u) {
+        int c = fine.coarse[u];
+        next.positions[c].x += fine.positions[u].x;
+        next.positions[c].y += fine.positions[u].y;
+        members[c]++;
+    }
+    for (int c = 0; c < coarseCount; ++c) {
+        next.positions[c].x /= members[c];
+        next.positions[c].y /= members[c];
+    }
+
+    next.offsets.assign(coarseCount + 1, 0);
+    for (int u = 0; u < n; ++u) {
+        for (int i = fine.offsets[u]; i < fine.offsets[u + 1]; ++i) {
+            if (fine.coarse[fine.neighbors[i]] != fine.coarse[u]) next.offsets[fine.coarse[u] + 1]++;
+        }
+    }
+    for (int c = 0; c < coarseCount; ++c) next.offsets[c + 1] += next.offsets[c];
+
+    next.neighbors.resize(next.offsets[coarseCount]);
+    std::vector<int> fill(next.offsets.begin(), next.offsets.end() - 1);
+    for (int u = 0; u < n; ++u) {
+        for (int i = fine.offsets[u]; i < fine.offsets[u + 1]; ++i) {
+            int c = fine.coarse[fine.neighbors[i]];
+            if (c != fine.coarse[u]) next.neighbors[fill[fine.coarse[u]]++] = c;
+        }
+    }
+    Compact(next, fill);
+    return true;
+}
+
+void ForceLayout::StartLevel(int index) {
+    level = index;
+    const Level& current = levels[level];
+    step = current.edgeLength;
+
+    // The coarsest level starts from averaged, often arbitrary positions
+    // and may need to move nodes across the whole layout.
+    if (level == static_cast<int>(levels.size()) - 1 && current.NodeCount() > 1) {
+        Vector2 lo, hi;
+        Bounds(current.positions, lo, hi);
+        step = std::max(step, HOT_START * std::max(hi.x - lo.x, hi.y - lo.y));
+    }
+
+    lastEnergy = std::numeric_limits<double>::infinity();
+    progress = 0;
+    levelIteration = 0;
+}
+
+void ForceLayout::SortNodes(const std::vector<Vector2>& positions) {
+    const int n = static_cast<int>(positions.size());
+
+    Vector2 lo, hi;
+    Bounds(positions, lo, hi);
+    boxOrigin = lo;
+    boxSize = std::max({ hi.x - lo.x, hi.y - lo.y, MIN_DISTANCE }) * 1.0001f;
+
+    keys.resize(n);
+    sortBuffer.resize(n);
+    pool.ParallelFor(n, FILL_GRAIN, [&](int begin, int end, int) {
+        for (int u = begin; u < end; ++u) {
+            uint32_t x = GridCoordinate(positions[u].x - boxOrigin.x, boxSize);
+            uint32_t y = GridCoordinate(positions[u].y - boxOrigin.y, boxSize);
+            uint32_t code = SpreadBits(x) | (SpreadBits(y) << 1);
+            keys[u] = (static_cast<uint64_t>(code) << 32) | static_cast<uint32_t>(u);
+        }
+    });
+
+    // LSD radix sort on the code bytes. Nodes barely move between
+    // iterations, but this costs the same either way.
+    for (int shift = 32; shift < 64; shift += 8) {
+        size_t counts[257] = {};
+        for (uint64_t key : keys) counts[((key >> shift) & 0xff) + 1]++;
+        for (int b = 0; b < 256; ++b) counts[b + 1] += counts[b];
+        for (uint64_t key : keys) sortBuffer[counts[(key >> shift) & 0xff]++] = key;
+        keys.swap(sortBuffer);
+    }
+
+    order.resize(n);
+    rank.resize(n);
+    sorted.resize(n);
+    codes.resize(n);
+    pool.ParallelFor(n, FILL_GRAIN, [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            int u = static_cast<int>(static_cast<uint32_t>(keys[i]));
+            order[i] = u;
+            rank[u] = i;
+            sorted[i] = positions[u];
+            codes[i] = static_cast<uint32_t>(keys[i] >> 32);
+        }
+    });
+}
+
+void ForceLayout::BuildCell(int index, int begin, int end, int depth, Vector2 origin, float size) {
+    cells[index] = { 0.0f, 0.0f, static_cast<float>(end - begin), size, begin, end, -1, 0 };
+
+    if (end - begin <= LEAF_SIZE || depth == MORTON_BITS) {
+        float x = 0.0f;
+        float y = 0.0f;
+        for (int i = begin; i < end; ++i) {
+            x += sorted[i].x;
+            y += sorted[i].y;
+        }
+        cells[index].x = x / (end - begin);
+        cells[index].y = y / (end - begin);
+        return;
+    }
+
+    // Every code in the cell shares its top 2 * depth bits; the next two
+    // pick the quadrant (bit 0 x, bit 1 y).
+    int shift = 2 * (MORTON_BITS - 1 - depth);
+    uint32_t prefix = codes[begin] & static_cast<uint32_t>(~((uint64_t(1) << (shift + 2)) - 1));
+    int cuts[5] = { begin, 0, 0, 0, end };
+    for (uint32_t q = 1; q < 4; ++q) {
+        cuts[q] = static_cast<int>(std::lower_bound(codes.begin() + cuts[q - 1], codes.begin() + end,
+                                                    prefix | (q << shift)) - codes.begin());
+    }
+
+    // Slots for all children first, so they sit side by side.
+    int childCount = 0;
+    for (int q = 0; q < 4; ++q) childCount += cuts[q] < cuts[q + 1];
+    int firstChild = static_cast<int>(cells.size());
+    cells[index].firstChild = firstChild;
+    cells[index].childCount = childCount;
+    cells.resize(firstChild + childCount);
+
+    float half = size / 2.0f;
+    float x = 0.0f;
+    float y = 0.0f;
+    int slot = firstChild;
+    for (int q = 0; q < 4; ++q) {
+        if (cuts[q] == cuts[q + 1]) continue;
+        Vector2 childOrigin = { origin.x + (q & 1) * half, origin.y + (q >> 1) * half };
+        BuildCell(slot, cuts[q], cuts[q + 1], depth + 1, childOrigin, half);
+        x += cells[slot].x * cells[slot].mass;
+        y += cells[slot].y * cells[slot].mass;
+        slot++;
+    }
+    cells[index].x = x / (end - begin);
+    cells[index].y = y / (end - begin);
+}
+
+Vector2 ForceLayout::Repulsion(int i, float strength) const {
+    const float theta2 = options.theta * options.theta;
+    const Vector2 p = sorted[i];
+
+    float fx = 0.0f;
+    float fy = 0.0f;
+    int stack[WALK_STACK_SIZE];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const Cell& cell = cells[stack[--top]];
+
+        if (cell.firstChild == -1) {
+            for (int j = cell.begin; j < cell.end; ++j) {
+                if (j == i) continue;
+                float dx = p.x - sorted[j].x;
+                float dy = p.y - sorted[j].y;
+                float d2 = dx * dx + dy * dy;
+                if (d2 < MIN_DISTANCE * MIN_DISTANCE) {
+                    float angle = (i - j) * GOLDEN_ANGLE;
+                    dx = MIN_DISTANCE * std::cos(angle);
+                    dy = MIN_DISTANCE * std::sin(angle);
+                    d2 = MIN_DISTANCE * MIN_DISTANCE;
+                }
+                fx += dx * strength / d2;
+                fy += dy * strength / d2;
+            }
+            continue;
+        }
+
+        float dx = p.x - cell.x;
+        float dy = p.y - cell.y;
+        float d2 = dx * dx + dy * dy;
+
+        // A cell holding the node itself is always opened.
+        bool inside = i >= cell.begin && i < cell.end;
+        if (!inside && cell.size * cell.size < theta2 * d2) {
+            fx += dx * cell.mass * strength / d2;
+            fy += dy * cell.mass * strength / d2;
+            continue;
+        }
+
+        for (int c = 0; c < cell.childCount; ++c) stack[top++] = cell.firstChild + c;
+    }
+
+    return { fx, fy };
+}
+
+bool ForceLayout::Step() {
+    if (finished) return false;
+
+    Level& current = levels[level];
+    const int n = current.NodeCount();
+    const float edgeLength = current.edgeLength;
+
+    if (n > 1) {
+        SortNodes(current.positions);
+        cells.resize(1);
+        BuildCell(0, 0, n, 0, boxOrigin, boxSize);
+        const Vector2 centroid = { cells[0].x, cells[0].y };
+        const float strength = REPULSION * edgeLength * edgeLength;
+
+        // Reads only the sorted copy, so positions can be updated in place.
+        std::fill(workerEnergy.begin(), workerEnergy.end(), 0.0);
+        pool.ParallelFor(n, FORCE_GRAIN, [&](int begin, int end, int worker) {
+            double energy = 0.0;
+            for (int i = begin; i < end; ++i) {
+                int u = order[i];
+                Vector2 p = sorted[i];
+                Vector2 f = Repulsion(i, strength);
+
+                for (int k = current.offsets[u]; k < current.offsets[u + 1]; ++k) {
+                    Vector2 q = sorted[rank[current.neighbors[k]]];
+                    float dx = q.x - p.x;
+                    float dy = q.y - p.y;
+                    float d = std::sqrt(dx * dx + dy * dy);
+                    f.x += dx * d / edgeLength;
+                    f.y += dy * d / edgeLength;
+                }
+
+                f.x += (centroid.x - p.x) * options.gravity;
+                f.y += (centroid.y - p.y) * options.gravity;
+
+                float norm2 = f.x * f.x + f.y * f.y;
+                energy += norm2;
+                if (norm2 > 0.0f) {
+                    float scale = step / std::sqrt(norm2);
+                    current.positions[u] = { p.x + f.x * scale, p.y + f.y * scale };
+                }
+            }
+            workerEnergy[worker] += energy;
+        });
+
+        double energy = 0.0;
+        for (double e : workerEnergy) energy += e;
+
+        if (energy < lastEnergy) {
+            if (++progress >= STEP_PATIENCE) {
+                progress = 0;
+                step /= STEP_DECAY;
+            }
+        } else {
+            progress = 0;
+            step *= STEP_DECAY;
+        }
+        lastEnergy = energy;
+        levelIteration++;
+        iteration++;
+    }
+
+    bool converged = n < 2 || step < options.tolerance * edgeLength;
+    if (!converged && levelIteration < options.maxIterations) return true;
+
+    if (level == 0) {
+        finished = true;
+        return false;
+    }
+
+    // Matched nodes start out slightly apart rather than on top of each other.
+    Level& fine = levels[level - 1];
+    for (int u = 0; u < fine.NodeCount(); ++u) {
+        Vector2 p = current.positions[fine.coarse[u]];
+        float spread = PROLONG_SPREAD * fine.edgeLength;
+        fine.positions[u] = { p.x + spread * std::cos(u * GOLDEN_ANGLE), p.y + spread * std::sin(u * GOLDEN_ANGLE) };
+    }
+    StartLevel(level - 1);
+    return true;
+}
+
+bool ForceLayout::RunFor(float budgetMs) {
+    auto start = std::chrono::steady_clock::now();
+    while (Step()) {
+        if (std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() >= budgetMs) break;
+    }
+    return !finished;
+}
+
+int ForceLayout::Run(const CsrGraph& graph) {
+    Begin(graph);
+    while (Step()) {}
+    return iteration;
+}
+
+const std::vector<Vector2>& ForceLayout::GetPositions() {
+    if (level == 0) return levels[0].positions;
+
+    projected = levels[level].positions;
+    std::vector<Vector2> finer;
+    for (int l = level - 1; l >= 0; --l) {
+        const std::vector<int>& coarse = levels[l].coarse;
+        finer.resize(coarse.size());
+        for (size_t u = 0; u < coarse.size(); ++u) finer[u] = projected[coarse[u]];
+        projected.swap(finer);
+    }
+    return projected;
+}
+
+void ForceLayout::Apply(Graph& graph) {
+    graph.SetNodePositions(nodeIds, GetPositions());
+}
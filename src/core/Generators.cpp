@@ -0,0 +1,167 @@
+#include "../../include/core/Generators.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// SplitMix64: tiny, fast and bit-for-bit reproducible everywhere.
+class Rng {
+private:
+    uint64_t state;
+
+public:
+    explicit Rng(uint64_t seed) : state(seed) {}
+
+    uint64_t Next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, 1).
+    float NextFloat() {
+        return static_cast<float>(Next() >> 40) * (1.0f / 16777216.0f);
+    }
+
+    // Uniform in [0, n).
+    uint32_t NextBelow(uint32_t n) {
+        return static_cast<uint32_t>(((Next() >> 32) * n) >> 32);
+    }
+};
+
+// Side of the square the random generators scatter nodes in, chosen so the
+// node density roughly matches a grid with 60px spacing.
+float SquareSide(int nodeCount) {
+    return 60.0f * std::sqrt(static_cast<float>(nodeCount));
+}
+
+}
+
+void GenerateGrid(Graph& graph, int width, int height, float spacing) {
+    graph.Reserve(graph.GetNodeCount() + static_cast<size_t>(width) * height);
+
+    std::vector<int> ids(static_cast<size_t>(width) * height);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            ids[y * width + x] = graph.AddNode({ x * spacing, y * spacing });
+        }
+    }
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            int id = ids[y * width + x];
+            if (x + 1 < width)  graph.AddEgde(id, ids[y * width + x + 1], spacing);
+            if (y + 1 < height) graph.AddEgde(id, ids[(y + 1) * width + x], spacing);
+        }
+    }
+}
+
+void GenerateRandomGeometric(Graph& graph, int nodeCount, float averageDegree, uint32_t seed) {
+    if (nodeCount <= 0) return;
+
+    Rng rng(seed);
+    const float side = SquareSide(nodeCount);
+    const float radius = side * std::sqrt(averageDegree / (3.14159265f * nodeCount));
+
+    graph.Reserve(graph.GetNodeCount() + nodeCount);
+
+    std::vector<int> ids(nodeCount);
+    std::vector<Vector2> positions(nodeCount);
+    for (int i = 0; i < nodeCount; ++i) {
+        positions[i] = { rng.NextFloat() * side, rng.NextFloat() * side };
+        ids[i] = graph.AddNode(positions[i]);
+    }
+
+    // Bucket points into radius-sized cells so each point only checks the
+    // 3x3 block around it. Counting sort keeps the buckets in one array.
+    const int cells = std::max(1, static_cast<int>(side / radius));
+    const float cellSize = side / cells;
+    auto cellOf = [&](float v) { return std::min(cells - 1, static_cast<int>(v / cellSize)); };
+
+    std::vector<int> cellStart(static_cast<size_t>(cells) * cells + 1, 0);
+    for (const Vector2& p : positions) {
+        cellStart[cellOf(p.y) * cells + cellOf(p.x) + 1]++;
+    }
+    for (size_t c = 1; c < cellStart.size(); ++c) {
+        cellStart[c] += cellStart[c - 1];
+    }
+    std::vector<int> cellFill(cellStart.begin(), cellStart.end() - 1);
+    std::vector<int> bucketed(nodeCount);
+    for (int i = 0; i < nodeCount; ++i) {
+        bucketed[cellFill[cellOf(positions[i].y) * cells + cellOf(positions[i].x)]++] = i;
+    }
+
+    const float radiusSq = radius * radius;
+    for (int i = 0; i < nodeCount; ++i) {
+        int cx = cellOf(positions[i].x);
+        int cy = cellOf(positions[i].y);
+
+        for (int ny = std::max(0, cy - 1); ny <= std::min(cells - 1, cy + 1); ++ny) {
+            for (int nx = std::max(0, cx - 1); nx <= std::min(cells - 1, cx + 1); ++nx) {
+                int cell = ny * cells + nx;
+                for (int k = cellStart[cell]; k < cellStart[cell + 1]; ++k) {
+                    int j = bucketed[k];
+                    if (j <= i) continue;
+
+                    float dx = positions[i].x - positions[j].x;
+                    float dy = positions[i].y - positions[j].y;
+                    if (dx * dx + dy * dy <= radiusSq) {
+                        graph.AddEgde(ids[i], ids[j], std::sqrt(dx * dx + dy * dy));
+                    }
+                }
+            }
+        }
+    }
+}
+
+void GenerateScaleFree(Graph& graph, int nodeCount, int edgesPerNode, uint32_t seed) {
+    if (nodeCount <= 0) return;
+
+    Rng rng(seed);
+    const float side = SquareSide(nodeCount);
+    const int m = std::max(1, std::min(edgesPerNode, nodeCount - 1));
+
+    graph.Reserve(graph.GetNodeCount() + nodeCount);
+
+    std::vector<int> ids(nodeCount);
+    std::vector<Vector2> positions(nodeCount);
+    for (int i = 0; i < nodeCount; ++i) {
+        positions[i] = { rng.NextFloat() * side, rng.NextFloat() * side };
+        ids[i] = graph.AddNode(positions[i]);
+    }
+
+    // Every edge endpoint is appended here, so a uniform pick from this list
+    // is a degree-proportional pick of a node.
+    std::vector<int> endpoints;
+    endpoints.reserve(static_cast<size_t>(nodeCount) * m * 2);
+
+    auto link = [&](int a, int b) {
+        graph.AddEgde(ids[a], ids[b], Distance(positions[a], positions[b]));
+        endpoints.push_back(a);
+        endpoints.push_back(b);
+    };
+
+    // Seed with a small clique so the first attachments have targets.
+    const int core = std::min(nodeCount, m + 1);
+    for (int a = 0; a < core; ++a) {
+        for (int b = a + 1; b < core; ++b) {
+            link(a, b);
+        }
+    }
+
+    std::vector<int> chosen;
+    for (int i = core; i < nodeCount; ++i) {
+        chosen.clear();
+        while (static_cast<int>(chosen.size()) < m) {
+            int target = endpoints[rng.NextBelow(static_cast<uint32_t>(endpoints.size()))];
+            if (std::find(chosen.begin(), chosen.end(), target) == chosen.end()) {
+                chosen.push_back(target);
+            }
+        }
+        for (int target : chosen) {
+            link(i, target);
+        }
+    }
+}
@@ -1,40 +1,154 @@
 #include "../../include/core/Graph.hpp" 
-#include "raymath.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
 #include <string>
+#include <utility>
+
+// Edge edits kept for the next snapshot's history.
+constexpr size_t MAX_PENDING_CHANGES = 4096;
+
+void Graph::Reserve(size_t nodeCount) {
+    nodes.Reserve(nodeCount);
+    adjacencyList.reserve(nodeCount);
+    componentParent.reserve(nodeCount);
+    componentSize.reserve(nodeCount);
+}
 
 int Graph::AddNode(Vector2 position) {
     int id = nextId++;
-    nodes[id] = { id, position, std::to_string(id), COLOR_DEFAULT };
+    nodes.Add(position, COLOR_DEFAULT);
+    spatialIndex.Insert(id, position);
+    componentParent.push_back(id);
+    componentSize.push_back(1);
+    componentCount++;
+    version++;
     return id;
 }
 
 void Graph::AddEgde(int fromId, int toId, float weight, bool biDirection) {
-    if (nodes.find(fromId) != nodes.end() && nodes.find(toId) != nodes.end()) {
+    // Ids are handed out sequentially and only ClearAll removes nodes, so
+    // a range check is an exact (and cache-friendly) existence test.
+    if (fromId >= 0 && fromId < nextId && toId >= 0 && toId < nextId) {
         adjacencyList[fromId].push_back({ toId, weight });
+        RecordChange(fromId, toId, std::numeric_limits<float>::infinity(), weight);
         
         if (biDirection) {
             adjacencyList[toId].push_back({ fromId, weight });
+            RecordChange(toId, fromId, std::numeric_limits<float>::infinity(), weight);
+        } else {
+            oneWayEdgeCount++;
         }
+
+        UniteComponents(fromId, toId);
+
+        version++;
     }
 }
 
-void Graph::ResetGraphVisuals() {
-    for (auto& [id, node] : nodes) {
-        node.ResetVisuals();
+bool Graph::SetEdgeWeight(int fromId, int toId, float weight, bool biDirection) {
+    bool found = false;
+    for (int pass = 0; pass < (biDirection ? 2 : 1); ++pass) {
+        int from = pass == 0 ? fromId : toId;
+        int to = pass == 0 ? toId : fromId;
+
+        auto it = adjacencyList.find(from);
+        if (it == adjacencyList.end()) continue;
+
+        for (Edge& edge : it->second) {
+            if (edge.targetNodeId != to) continue;
+            found = true;
+            if (edge.weight == weight) continue;
+
+            RecordChange(from, to, edge.weight, weight);
+            edge.weight = weight;
+            version++;
+        }
+    }
+    return found;
+}
+
+int Graph::FindComponent(int id) {
+    if (id < 0 || id >= nextId) return -1;
+
+    // Path halving: every other node on the way up skips to its grandparent.
+    while (componentParent[id] != id) {
+        componentParent[id] = componentParent[componentParent[id]];
+        id = componentParent[id];
+    }
+    return id;
+}
+
+void Graph::UniteComponents(int a, int b) {
+    a = FindComponent(a);
+    b = FindComponent(b);
+    if (a == b) return;
+
+    // Union by size keeps the trees logarithmically shallow.
+    if (componentSize[a] < componentSize[b]) std::swap(a, b);
+    componentParent[b] = a;
+    componentSize[a] += componentSize[b];
+    componentCount--;
+}
+
+void Graph::RecordChange(int fromId, int toId, float oldWeight, float newWeight) {
+    if (changesLost) return;
+    if (pendingChanges.size() == MAX_PENDING_CHANGES) {
+        pendingChanges.clear();
+        pendingChanges.shrink_to_fit();
+        changesLost = true;
+        return;
     }
+    pendingChanges.push_back({ fromId, toId, oldWeight, newWeight });
+}
+
+void Graph::SetNodePosition(int id, Vector2 position) {
+    if (nodes.Contains(id)) {
+        spatialIndex.Move(id, nodes.Position(id), position);
+        nodes.SetPosition(id, position);
+        version++;
+    }
+}
+
+void Graph::SetNodePositions(const std::vector<int>& ids, const std::vector<Vector2>& positions) {
+    size_t count = std::min(ids.size(), positions.size());
+    for (size_t i = 0; i < count; ++i) {
+        if (nodes.Contains(ids[i])) nodes.SetPosition(ids[i], positions[i]);
+    }
+
+    spatialIndex.Clear();
+    for (int id = 0; id < nextId; ++id) {
+        if (nodes.Contains(id)) spatialIndex.Insert(id, nodes.Position(id));
+    }
+    version++;
+}
+
+void Graph::SetNodeColor(int id, Color color) {
+    if (nodes.Contains(id)) nodes.SetColor(id, color);
+}
+
+void Graph::SetNodeLabel(int id, const std::string& label) {
+    if (nodes.Contains(id)) nodes.SetLabel(id, label);
+}
+
+void Graph::ResetGraphVisuals() {
+    nodes.FillColor(COLOR_DEFAULT);
 }
 
 void Graph::ClearAll() {
-    nodes.clear();
+    nodes.Clear();
     adjacencyList.clear();
+    spatialIndex.Clear();
+    componentParent.clear();
+    componentSize.clear();
+    componentCount = 0;
+    oneWayEdgeCount = 0;
     nextId = 0;
-}
+    version++;
 
-Node* Graph::GetNode(int id) {
-    if (nodes.find(id) != nodes.end()) {
-        return &nodes[id];
-    }
-    return nullptr;
+    // Ids restart from 0, so the next snapshot shares nothing with the last.
+    pendingChanges.clear();
+    changesLost = true;
 }
 
 const std::vector<Edge>& Graph::GetNeighbors(int id) const {
@@ -47,51 +161,43 @@ const std::vector<Edge>& Graph::GetNeighbors(int id) const {
     return empty;
 }
 
-std::vector<int> Graph::GetAllNodeIds() const {
-    std::vector<int> ids;
-    ids.reserve(nodes.size());
-    for (const auto& [id, node] : nodes) {
-        ids.push_back(id);
+const CsrGraph& Graph::GetSnapshot() {
+    if (snapshotVersion != version) {
+        // Build hands out a new id, so read the old one first. There is no
+        // history before the first build.
+        uint64_t previousBuildId = snapshotVersion != UINT64_MAX ? snapshot.GetBuildId() : 0;
+        snapshot.Build(*this);
+        snapshotVersion = version;
+
+        if (previousBuildId != 0 && !changesLost) snapshot.SetHistory(previousBuildId, std::move(pendingChanges));
+        pendingChanges.clear();
+        changesLost = false;
     }
-    return ids;
+    return snapshot;
 }
 
-void Graph::Draw(Font font) {
-    for (const auto& [sourceId, sourceNode] : nodes) {
-        if (adjacencyList.find(sourceId) != adjacencyList.end()) {
-            for (const auto& edge : adjacencyList.at(sourceId)) {
-                if (nodes.find(edge.targetNodeId) != nodes.end()) {
-                    Vector2 targetPos = nodes.at(edge.targetNodeId).position;
-
-                    DrawLineEx(sourceNode.position, targetPos, 2.0f, BLACK);
+std::vector<int> Graph::GetAllNodeIds() const {
+    std::vector<int> ids(nodes.Size());
+    std::iota(ids.begin(), ids.end(), 0);
+    return ids;
+}
 
-                    Vector2 mid = { 
-                        (sourceNode.position.x + targetPos.x) / 2.0f,
-                        (sourceNode.position.y + targetPos.y) / 2.0f 
-                    };
+int Graph::GetNodeAtPosition(Vector2 pos) const {
+    return spatialIndex.QueryPoint(pos, NODE_RADIUS);
+}
 
-                    char buff[16];
-                    snprintf(buff, sizeof(buff), "%.1f", edge.weight);
-                    DrawTextEx(font, buff, mid, 12, 1, DARKGRAY);
-                }
-            }
-        }
-    }
+int Graph::GetNearestNode(Vector2 pos) const {
+    return spatialIndex.Nearest(pos);
+}
 
-    for (const auto& [id, node] : nodes) {
-        DrawCircleV(node.position, NODE_RADIUS, node.color);
-        DrawCircleLines(node.position.x, node.position.y, NODE_RADIUS, BLACK);
-        DrawTextEx(font, node.label.c_str(), 
-                  { node.position.x - 5, node.position.y - 10 }, 
-                  20, 1, WHITE);
-    }
+std::vector<int> Graph::GetNodesInRect(Vector2 min, Vector2 max) const {
+    std::vector<int> ids;
+    spatialIndex.QueryRect(min, max, ids);
+    return ids;
 }
 
-int Graph::GetNodeAtPosition(Vector2 pos) const {
-    for (const auto& [id, node] : nodes) {
-        if (CheckCollisionPointCircle(pos, node.position, NODE_RADIUS)) {
-            return id;
-        }
-    }
-    return -1;
-}
\ No newline at end of file
+std::vector<int> Graph::GetNodesInRadius(Vector2 center, float radius) const {
+    std::vector<int> ids;
+    spatialIndex.QueryRadius(center, radius, ids);
+    return ids;
+}
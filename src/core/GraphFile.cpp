@@ -0,0 +1,292 @@
+#include "../../include/core/GraphFile.hpp"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <tuple>
+
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+constexpr uint64_t SECTION_ALIGNMENT = 64;
+
+static uint64_t AlignUp(uint64_t value) {
+    return (value + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+}
+
+static bool Fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+bool SaveGraphFile(const std::string& path, Graph& graph,
+                   const std::vector<GraphFileBlob>& extras, std::string* error) {
+    const CsrGraph& csr = graph.GetSnapshot();
+    const uint64_t n = csr.NodeCount();
+    const uint64_t m = csr.EdgeCount();
+
+    std::vector<uint64_t> labelOffsets(n + 1, 0);
+    std::string labelBytes;
+    for (uint64_t u = 0; u < n; ++u) {
+        labelOffsets[u] = labelBytes.size();
+        labelBytes += graph.GetNodeLabel(csr.ToNodeId(static_cast<int>(u)));
+    }
+    labelOffsets[n] = labelBytes.size();
+
+    std::vector<GraphFileBlob> blobs = {
+        { SECTION_NODE_IDS, csr.NodeIdsData(), n * sizeof(int) },
+        { SECTION_DENSE_INDEX, csr.DenseIndexData(), static_cast<uint64_t>(csr.MaxNodeId() + 1) * sizeof(int) },
+        { SECTION_POSITIONS, csr.PositionsData(), n * sizeof(Vector2) },
+        { SECTION_OFFSETS, csr.OffsetsData(), (n + 1) * sizeof(int) },
+        { SECTION_TARGETS, csr.TargetsData(), m * sizeof(int) },
+        { SECTION_WEIGHTS, csr.WeightsData(), m * sizeof(float) },
+        { SECTION_LABEL_OFFSETS, labelOffsets.data(), (n + 1) * sizeof(uint64_t) },
+        { SECTION_LABEL_BYTES, labelBytes.data(), labelBytes.size() },
+    };
+    blobs.insert(blobs.end(), extras.begin(), extras.end());
+
+    GraphFileHeader header = {};
+    std::memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic));
+    header.version = GRAPH_FILE_VERSION;
+    header.byteOrder = GRAPH_FILE_BYTE_ORDER;
+    header.nodeCount = n;
+    header.edgeCount = m;
+    header.denseIndexSize = csr.MaxNodeId() + 1;
+    header.sectionCount = static_cast<uint32_t>(blobs.size());
+
+    std::vector<GraphFileSection> table(blobs.size());
+    uint64_t cursor = AlignUp(sizeof(GraphFileHeader) + table.size() * sizeof(GraphFileSection));
+    for (size_t i = 0; i < blobs.size(); ++i) {
+        table[i] = { blobs[i].tag, 0, cursor, blobs[i].size };
+        cursor = AlignUp(cursor + blobs[i].size);
+    }
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return Fail(error, "cannot create " + path);
+
+    static const char padding[SECTION_ALIGNMENT] = {};
+    uint64_t written = 0;
+    auto write = [&](const void* bytes, uint64_t count) {
+        if (count > 0 && std::fwrite(bytes, 1, count, file) != count) return false;
+        written += count;
+        return true;
+    };
+    auto padTo = [&](uint64_t offset) {
+        return write(padding, offset - written);
+    };
+
+    bool ok = write(&header, sizeof(header)) && write(table.data(), table.size() * sizeof(GraphFileSection));
+    for (size_t i = 0; ok && i < blobs.size(); ++i) {
+        ok = padTo(table[i].offset) && write(blobs[i].data, blobs[i].size);
+    }
+    ok = ok && padTo(cursor);
+
+    if (std::fclose(file) != 0) ok = false;
+    if (!ok) return Fail(error, "write failed: " + path);
+    return true;
+}
+
+bool LoadGraphFile(const std::string& path, Graph& graph, std::string* error) {
+    MappedGraphFile file;
+    if (!file.Open(path, error)) return false;
+
+    const CsrGraph& csr = file.GetCsr();
+    graph.ClearAll();
+    graph.Reserve(csr.NodeCount());
+
+    for (int u = 0; u < csr.NodeCount(); ++u) {
+        int id = graph.AddNode(csr.Position(u));
+        graph.SetNodeLabel(id, std::string(file.GetLabel(u)));
+    }
+
+    // The file only has directed edges. Pair each with an unused reverse
+    // edge of the same weight where there is one and add the pair as one
+    // two-way edge, so an undirected graph comes back undirected (and its
+    // snapshots skip the strongly connected components pass).
+    const int m = csr.EdgeCount();
+    std::vector<int> tails(m);
+    for (int u = 0; u < csr.NodeCount(); ++u) {
+        for (int e = csr.EdgesBegin(u); e < csr.EdgesEnd(u); ++e) tails[e] = u;
+    }
+    auto key = [&](int e) { return std::make_tuple(tails[e], csr.Target(e), csr.Weight(e)); };
+    std::vector<int> order(m);
+    for (int e = 0; e < m; ++e) order[e] = e;
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return key(a) < key(b); });
+
+    // Graph ids are 0..N-1 in dense order, so dense indices are ids here.
+    std::vector<uint8_t> paired(m, 0);
+    for (int e = 0; e < m; ++e) {
+        if (paired[e]) continue;
+        int u = tails[e], v = csr.Target(e);
+        auto reverse = std::make_tuple(v, u, csr.Weight(e));
+        auto it = std::lower_bound(order.begin(), order.end(), reverse,
+                                   [&](int f, const auto& k) { return key(f) < k; });
+        for (; it != order.end() && key(*it) == reverse; ++it) {
+            if (*it != e && !paired[*it]) break;
+        }
+        bool twoWay = it != order.end() && key(*it) == reverse;
+        if (twoWay) paired[*it] = 1;
+        graph.AddEgde(u, v, csr.Weight(e), twoWay);
+    }
+    return true;
+}
+
+MappedGraphFile::~MappedGraphFile() {
+    Close();
+}
+
+void MappedGraphFile::Close() {
+#if !defined(_WIN32)
+    if (data && fallback.empty()) {
+        munmap(const_cast<char*>(data), size);
+    }
+#endif
+    fallback.clear();
+    data = nullptr;
+    size = 0;
+    header = nullptr;
+    sections = nullptr;
+    labelOffsets = nullptr;
+    labelBytes = nullptr;
+    csr.Clear();
+}
+
+const void* MappedGraphFile::FindSection(uint32_t tag, uint64_t* sectionSize) const {
+    if (!header) return nullptr;
+
+    for (uint32_t i = 0; i < header->sectionCount; ++i) {
+        if (sections[i].tag == tag) {
+            if (sectionSize) *sectionSize = sections[i].size;
+            return data + sections[i].offset;
+        }
+    }
+    return nullptr;
+}
+
+std::string_view MappedGraphFile::GetLabel(int u) const {
+    if (!labelOffsets) return {};
+    return std::string_view(labelBytes + labelOffsets[u], labelOffsets[u + 1] - labelOffsets[u]);
+}
+
+bool MappedGraphFile::Open(const std::string& path, std::string* error) {
+    Close();
+
+#if defined(_WIN32)
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return Fail(error, "cannot open " + path);
+    fallback.resize(static_cast<size_t>(in.tellg()));
+    in.seekg(0);
+    if (!in.read(fallback.data(), fallback.size())) return Fail(error, "read failed: " + path);
+    data = fallback.data();
+    size = fallback.size();
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return Fail(error, "cannot open " + path);
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(GraphFileHeader))) {
+        ::close(fd);
+        return Fail(error, path + ": not a graph file");
+    }
+
+    void* mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) return Fail(error, "cannot map " + path);
+
+    data = static_cast<const char*>(mapping);
+    size = info.st_size;
+#endif
+
+    auto reject = [&](const std::string& why) {
+        Close();
+        return Fail(error, path + ": " + why);
+    };
+
+    if (size < sizeof(GraphFileHeader)) return reject("not a graph file");
+
+    const GraphFileHeader* h = reinterpret_cast<const GraphFileHeader*>(data);
+    if (std::memcmp(h->magic, GRAPH_FILE_MAGIC, sizeof(h->magic)) != 0) return reject("not a graph file");
+    if (h->byteOrder != GRAPH_FILE_BYTE_ORDER) return reject("written with a different byte order");
+    if (h->version != GRAPH_FILE_VERSION) {
+        return reject("unsupported version " + std::to_string(h->version));
+    }
+    if (sizeof(GraphFileHeader) + static_cast<uint64_t>(h->sectionCount) * sizeof(GraphFileSection) > size) {
+        return reject("truncated section table");
+    }
+
+    header = h;
+    sections = reinterpret_cast<const GraphFileSection*>(data + sizeof(GraphFileHeader));
+    for (uint32_t i = 0; i < header->sectionCount; ++i) {
+        if (sections[i].offset > size || sections[i].size > size - sections[i].offset) {
+            return reject("section out of bounds");
+        }
+    }
+
+    // CsrGraph indexes with int. Bounding the counts also keeps every
+    // section size below (INT_MAX + 1) * 8, so none of them can overflow.
+    const uint64_t n = header->nodeCount;
+    const uint64_t m = header->edgeCount;
+    const uint64_t denseIndexSize = header->denseIndexSize;
+    if (n > INT_MAX || m > INT_MAX || denseIndexSize > INT_MAX) return reject("graph too large");
+
+    // Fetch a core section and check it has exactly the expected size.
+    auto section = [&](uint32_t tag, uint64_t expected) -> const void* {
+        uint64_t actual = 0;
+        const void* p = FindSection(tag, &actual);
+        return (p && actual == expected) ? p : nullptr;
+    };
+
+    const int* nodeIds = static_cast<const int*>(section(SECTION_NODE_IDS, n * sizeof(int)));
+    const int* denseIndex = static_cast<const int*>(section(SECTION_DENSE_INDEX, denseIndexSize * sizeof(int)));
+    const Vector2* positions = static_cast<const Vector2*>(section(SECTION_POSITIONS, n * sizeof(Vector2)));
+    const int* offsets = static_cast<const int*>(section(SECTION_OFFSETS, (n + 1) * sizeof(int)));
+    const int* targets = static_cast<const int*>(section(SECTION_TARGETS, m * sizeof(int)));
+    const float* weights = static_cast<const float*>(section(SECTION_WEIGHTS, m * sizeof(float)));
+    labelOffsets = static_cast<const uint64_t*>(section(SECTION_LABEL_OFFSETS, (n + 1) * sizeof(uint64_t)));
+    uint64_t labelBytesSize = 0;
+    labelBytes = static_cast<const char*>(FindSection(SECTION_LABEL_BYTES, &labelBytesSize));
+
+    if (!nodeIds || !denseIndex || !positions || !offsets || !targets || !weights || !labelOffsets || !labelBytes) {
+        return reject("missing or malformed core section");
+    }
+
+    // The solvers and GetLabel index through these arrays unchecked, so
+    // every entry has to be in range.
+    if (offsets[0] != 0 || static_cast<uint64_t>(offsets[n]) != m) {
+        return reject("inconsistent edge offsets");
+    }
+    for (uint64_t u = 0; u < n; ++u) {
+        if (offsets[u] > offsets[u + 1]) return reject("inconsistent edge offsets");
+    }
+    for (uint64_t e = 0; e < m; ++e) {
+        if (targets[e] < 0 || static_cast<uint64_t>(targets[e]) >= n) return reject("edge target out of range");
+        if (!(weights[e] >= 0.0f) || std::isinf(weights[e])) return reject("edge weight must be finite and non-negative");
+    }
+    for (uint64_t u = 0; u < n; ++u) {
+        int id = nodeIds[u];
+        if (id < 0 || static_cast<uint64_t>(id) >= denseIndexSize || denseIndex[id] != static_cast<int>(u)) {
+            return reject("node ids do not match the dense index");
+        }
+    }
+    for (uint64_t id = 0; id < denseIndexSize; ++id) {
+        int u = denseIndex[id];
+        if (u != -1 && (u < 0 || static_cast<uint64_t>(u) >= n || static_cast<uint64_t>(nodeIds[u]) != id)) {
+            return reject("node ids do not match the dense index");
+        }
+    }
+    for (uint64_t u = 0; u < n; ++u) {
+        if (labelOffsets[u] > labelOffsets[u + 1]) return reject("inconsistent label offsets");
+    }
+    if (labelOffsets[n] > labelBytesSize) return reject("inconsistent label offsets");
+
+    csr.Attach(static_cast<int>(n), static_cast<int>(m), offsets, targets, weights,
+               nodeIds, denseIndex, static_cast<int>(denseIndexSize), positions);
+    return true;
+}
@@ -0,0 +1,82 @@
+#include "../../include/core/GraphIO.hpp"
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+static bool Fail(std::string* error, int lineNo, const std::string& message) {
+    if (error) {
+        *error = "line " + std::to_string(lineNo) + ": " + message;
+    }
+    return false;
+}
+
+bool LoadGraphText(const std::string& path, Graph& graph, std::string* error) {
+    std::ifstream in(path);
+    if (!in) {
+        if (error) *error = "cannot open " + path;
+        return false;
+    }
+
+    // File order -> Graph id, so files stay valid when loaded into a non-empty graph.
+    std::vector<int> ids;
+
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        lineNo++;
+
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.resize(comment);
+
+        std::istringstream fields(line);
+        std::string kind;
+        if (!(fields >> kind)) continue;
+
+        if (kind == "n") {
+            Vector2 pos;
+            if (!(fields >> pos.x >> pos.y)) {
+                return Fail(error, lineNo, "expected 'n <x> <y>'");
+            }
+            ids.push_back(graph.AddNode(pos));
+        } else if (kind == "e") {
+            int from, to;
+            if (!(fields >> from >> to)) {
+                return Fail(error, lineNo, "expected 'e <from> <to> [weight] [d]'");
+            }
+            if (from < 0 || to < 0 || from >= (int)ids.size() || to >= (int)ids.size()) {
+                return Fail(error, lineNo, "edge references an undeclared node");
+            }
+
+            float weight = Distance(graph.GetNodePosition(ids[from]),
+                                    graph.GetNodePosition(ids[to]));
+            bool biDirection = true;
+
+            std::string token;
+            if (fields >> token) {
+                if (token == "d") {
+                    biDirection = false;
+                } else {
+                    try {
+                        weight = std::stof(token);
+                    } catch (...) {
+                        return Fail(error, lineNo, "bad weight '" + token + "'");
+                    }
+                    if (!(weight >= 0.0f) || std::isinf(weight)) {
+                        return Fail(error, lineNo, "weight must be finite and non-negative");
+                    }
+                    if (fields >> token) {
+                        if (token != "d") return Fail(error, lineNo, "unexpected '" + token + "'");
+                        biDirection = false;
+                    }
+                }
+            }
+
+            graph.AddEgde(ids[from], ids[to], weight, biDirection);
+        } else {
+            return Fail(error, lineNo, "unknown record '" + kind + "'");
+        }
+    }
+
+    return true;
+}
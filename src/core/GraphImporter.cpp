@@ -0,0 +1,351 @@
+#include "../../include/core/GraphImporter.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+namespace {
+
+constexpr size_t CHUNK_SIZE = 1 << 20;
+
+// Ids below this go into the flat table (256 MiB of ints at worst).
+constexpr long long DENSE_ID_LIMIT = 1ll << 26;
+
+constexpr long long NO_EXTERNAL_ID = std::numeric_limits<long long>::min();
+
+// Reads a file in CHUNK_SIZE blocks and hands out one line at a time as a
+// view into the block. Only a line that straddles two blocks is moved.
+class LineReader {
+private:
+    FILE* file = nullptr;
+    std::vector<char> buffer;
+    size_t begin = 0;
+    size_t end = 0;
+    bool eof = false;
+
+    void Refill() {
+        if (begin > 0) {
+            std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+            end -= begin;
+            begin = 0;
+        }
+        if (end == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        size_t read = std::fread(buffer.data() + end, 1, buffer.size() - end, file);
+        end += read;
+        if (read == 0) eof = true;
+    }
+
+public:
+    explicit LineReader(const std::string& path) : buffer(CHUNK_SIZE) {
+        file = std::fopen(path.c_str(), "rb");
+    }
+
+    ~LineReader() {
+        if (file) std::fclose(file);
+    }
+
+    bool IsOpen() const { return file != nullptr; }
+
+    long long FileSize() {
+        if (!file) return 0;
+        long current = std::ftell(file);
+        std::fseek(file, 0, SEEK_END);
+        long size = std::ftell(file);
+        std::fseek(file, current, SEEK_SET);
+        return size;
+    }
+
+    bool Next(std::string_view& line) {
+        while (true) {
+            const char* start = buffer.data() + begin;
+            const char* newline = static_cast<const char*>(std::memchr(start, '\n', end - begin));
+            if (newline) {
+                size_t length = newline - start;
+                begin += length + 1;
+                if (length > 0 && start[length - 1] == '\r') length--;
+                line = std::string_view(start, length);
+                return true;
+            }
+            if (eof) {
+                if (begin == end) return false;
+                line = std::string_view(start, end - begin);
+                begin = end;
+                return true;
+            }
+            Refill();
+        }
+    }
+};
+
+bool IsSeparator(char c) {
+    return c == ' ' || c == '\t' || c == ',' || c == ';';
+}
+
+// Splits off the next field; any run of spaces, tabs, commas or semicolons
+// separates fields.
+bool NextField(std::string_view& line, std::string_view& field) {
+    size_t i = 0;
+    while (i < line.size() && IsSeparator(line[i])) i++;
+    if (i == line.size()) return false;
+
+    size_t j = i;
+    while (j < line.size() && !IsSeparator(line[j])) j++;
+
+    field = line.substr(i, j - i);
+    line.remove_prefix(j);
+    return true;
+}
+
+template <typename T>
+bool ParseNumber(std::string_view field, T& value) {
+    const char* first = field.data();
+    const char* last = field.data() + field.size();
+    if (first != last && *first == '+') first++;
+    auto result = std::from_chars(first, last, value);
+    return result.ec == std::errc() && result.ptr == last;
+}
+
+template <typename T>
+bool NextNumber(std::string_view& line, T& value) {
+    std::string_view field;
+    return NextField(line, field) && ParseNumber(field, value);
+}
+
+bool Fail(std::string* error, const std::string& path, size_t lineNo, const std::string& message) {
+    if (error) {
+        *error = path + ":" + std::to_string(lineNo) + ": " + message;
+    }
+    return false;
+}
+
+// Every solver assumes non-negative weights; a negative one would make them
+// return wrong costs without any error. Also rejects weights that become
+// infinite as a float.
+bool IsValidWeight(double weight) {
+    return weight >= 0.0 && std::isfinite(static_cast<float>(weight));
+}
+
+bool EndsWith(const std::string& s, const char* suffix) {
+    size_t n = std::strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+}
+
+ImportFormat DetectImportFormat(const std::string& path) {
+    std::string lower = path;
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    if (EndsWith(lower, ".gr")) return ImportFormat::DimacsGraph;
+    if (EndsWith(lower, ".co")) return ImportFormat::DimacsCoordinates;
+    if (EndsWith(lower, ".nodes") || EndsWith(lower, ".xy")) return ImportFormat::NodeCoordinates;
+    if (EndsWith(lower, ".csv") || EndsWith(lower, ".edges") || EndsWith(lower, ".el")) return ImportFormat::EdgeList;
+    return ImportFormat::Auto;
+}
+
+GraphImporter::GraphImporter(Graph& graph, ImportOptions options) : graph(graph), options(options) {}
+
+int GraphImporter::FindNode(long long externalId) const {
+    if (externalId >= 0 && externalId < static_cast<long long>(denseIds.size())) {
+        return denseIds[externalId];
+    }
+    auto it = sparseIds.find(externalId);
+    return it != sparseIds.end() ? it->second : -1;
+}
+
+long long GraphImporter::ToExternalId(int nodeId) const {
+    if (nodeId >= 0 && nodeId < static_cast<int>(externalIds.size()) && externalIds[nodeId] != NO_EXTERNAL_ID) {
+        return externalIds[nodeId];
+    }
+    return nodeId;
+}
+
+int GraphImporter::ResolveNode(long long externalId) {
+    int* slot = nullptr;
+    if (externalId >= 0 && externalId < DENSE_ID_LIMIT) {
+        if (externalId >= static_cast<long long>(denseIds.size())) {
+            size_t grown = std::max<size_t>(externalId + 1, denseIds.size() * 2);
+            denseIds.resize(std::min<size_t>(grown, DENSE_ID_LIMIT), -1);
+        }
+        slot = &denseIds[externalId];
+    } else {
+        auto [it, inserted] = sparseIds.try_emplace(externalId, -1);
+        slot = &it->second;
+    }
+
+    if (*slot == -1) {
+        // Sunflower spiral: even spacing without knowing the final count.
+        double k = static_cast<double>(stats.nodesCreated);
+        double r = 60.0 * std::sqrt(k);
+        double theta = k * 2.399963229728653;
+        *slot = graph.AddNode({ static_cast<float>(r * std::cos(theta)), static_cast<float>(r * std::sin(theta)) });
+        stats.nodesCreated++;
+
+        if (*slot >= static_cast<int>(externalIds.size())) {
+            externalIds.resize(std::max<size_t>(*slot + 1, externalIds.size() * 2), NO_EXTERNAL_ID);
+        }
+        externalIds[*slot] = externalId;
+    }
+    return *slot;
+}
+
+Vector2 GraphImporter::ScalePosition(double x, double y) const {
+    float sx = static_cast<float>(x * options.coordinateScale);
+    float sy = static_cast<float>(y * options.coordinateScale);
+    return { sx, options.flipY ? -sy : sy };
+}
+
+bool GraphImporter::Import(const std::string& path, ImportFormat format, std::string* error) {
+    if (format == ImportFormat::Auto) {
+        format = DetectImportFormat(path);
+    }
+
+    switch (format) {
+        case ImportFormat::DimacsGraph:       return ImportDimacsGraph(path, error);
+        case ImportFormat::DimacsCoordinates: return ImportCoordinates(path, true, error);
+        case ImportFormat::NodeCoordinates:   return ImportCoordinates(path, false, error);
+        case ImportFormat::EdgeList:          return ImportEdgeList(path, error);
+        case ImportFormat::Auto:              break;
+    }
+
+    if (error) *error = path + ": unknown format (expected .gr, .co, .csv, .edges, .el, .nodes or .xy)";
+    return false;
+}
+
+bool GraphImporter::ImportDimacsGraph(const std::string& path, std::string* error) {
+    LineReader reader(path);
+    if (!reader.IsOpen()) {
+        if (error) *error = "cannot open " + path;
+        return false;
+    }
+
+    std::string_view line;
+    size_t lineNo = 0;
+    while (reader.Next(line)) {
+        lineNo++;
+        stats.lines++;
+        if (line.empty()) continue;
+
+        char kind = line[0];
+        line.remove_prefix(1);
+
+        if (kind == 'a') {
+            long long from, to;
+            double weight;
+            if (!NextNumber(line, from) || !NextNumber(line, to) || !NextNumber(line, weight)) {
+                return Fail(error, path, lineNo, "expected 'a <from> <to> <weight>'");
+            }
+            if (!IsValidWeight(weight)) {
+                return Fail(error, path, lineNo, "weight must be finite and non-negative");
+            }
+            graph.AddEgde(ResolveNode(from), ResolveNode(to), static_cast<float>(weight), false);
+            stats.edgesAdded++;
+        } else if (kind == 'p') {
+            std::string_view problem;
+            long long n, m;
+            if (!NextField(line, problem) || !NextNumber(line, n) || !NextNumber(line, m)) {
+                return Fail(error, path, lineNo, "expected 'p sp <nodes> <arcs>'");
+            }
+            if (n < 0 || m < 0 || n > INT_MAX - static_cast<long long>(graph.GetNodeCount())) {
+                return Fail(error, path, lineNo, "node and arc counts must be non-negative and fit in an int");
+            }
+            // Create every node up front so ids 1..n map to a contiguous id range.
+            graph.Reserve(graph.GetNodeCount() + n);
+            for (long long id = 1; id <= n; ++id) {
+                ResolveNode(id);
+            }
+        } else if (kind != 'c') {
+            return Fail(error, path, lineNo, std::string("unknown record '") + kind + "'");
+        }
+    }
+    return true;
+}
+
+bool GraphImporter::ImportCoordinates(const std::string& path, bool dimacs, std::string* error) {
+    LineReader reader(path);
+    if (!reader.IsOpen()) {
+        if (error) *error = "cannot open " + path;
+        return false;
+    }
+
+    std::string_view line;
+    size_t lineNo = 0;
+    while (reader.Next(line)) {
+        lineNo++;
+        stats.lines++;
+
+        std::string_view probe = line;
+        std::string_view first;
+        if (!NextField(probe, first) || first[0] == '#') continue;
+
+        if (dimacs) {
+            if (first == "c" || first == "p") continue;
+            if (first != "v") return Fail(error, path, lineNo, "unknown record '" + std::string(first) + "'");
+            line = probe;
+        } else if (lineNo == 1 && !std::isdigit(static_cast<unsigned char>(first[0])) && first[0] != '-') {
+            continue;  // header row
+        }
+
+        long long id;
+        double x, y;
+        if (!NextNumber(line, id) || !NextNumber(line, x) || !NextNumber(line, y)) {
+            return Fail(error, path, lineNo, dimacs ? "expected 'v <id> <x> <y>'" : "expected '<id>,<x>,<y>'");
+        }
+
+        graph.SetNodePosition(ResolveNode(id), ScalePosition(x, y));
+        stats.positionsSet++;
+    }
+    return true;
+}
+
+bool GraphImporter::ImportEdgeList(const std::string& path, std::string* error) {
+    LineReader reader(path);
+    if (!reader.IsOpen()) {
+        if (error) *error = "cannot open " + path;
+        return false;
+    }
+
+    // ~12 bytes per "from,to,weight" row is a conservative guess; reserving
+    // a rough node count up front avoids most rehashing on big files.
+    graph.Reserve(graph.GetNodeCount() + static_cast<size_t>(reader.FileSize() / 48));
+
+    std::string_view line;
+    size_t lineNo = 0;
+    while (reader.Next(line)) {
+        lineNo++;
+        stats.lines++;
+
+        std::string_view probe = line;
+        std::string_view first;
+        if (!NextField(probe, first) || first[0] == '#' || first[0] == '%') continue;
+
+        long long from, to;
+        if (!ParseNumber(first, from)) {
+            if (lineNo == 1) continue;  // header row
+            return Fail(error, path, lineNo, "expected '<from>,<to>[,<weight>]'");
+        }
+        if (!NextNumber(probe, to)) {
+            return Fail(error, path, lineNo, "expected '<from>,<to>[,<weight>]'");
+        }
+
+        double weight = 1.0;
+        std::string_view weightField;
+        if (NextField(probe, weightField) && !ParseNumber(weightField, weight)) {
+            return Fail(error, path, lineNo, "bad weight '" + std::string(weightField) + "'");
+        }
+        if (!IsValidWeight(weight)) {
+            return Fail(error, path, lineNo, "weight must be finite and non-negative");
+        }
+
+        graph.AddEgde(ResolveNode(from), ResolveNode(to), static_cast<float>(weight), !options.directed);
+        stats.edgesAdded++;
+    }
+    return true;
+}
@@ -0,0 +1,47 @@
+#include "../../include/core/NodeStore.hpp"
+#include <algorithm>
+
+void NodeStore::Reserve(size_t count) {
+    xs.reserve(count);
+    ys.reserve(count);
+    colors.reserve(count);
+    labelIndex.reserve(count);
+}
+
+void NodeStore::Clear() {
+    xs.clear();
+    ys.clear();
+    colors.clear();
+    labelIndex.clear();
+    labelTable.clear();
+    labelLookup.clear();
+}
+
+int NodeStore::Add(Vector2 position, Color color) {
+    int id = Size();
+    xs.push_back(position.x);
+    ys.push_back(position.y);
+    colors.push_back(color);
+    labelIndex.push_back(DEFAULT_LABEL);
+    return id;
+}
+
+void NodeStore::FillColor(Color color) {
+    std::fill(colors.begin(), colors.end(), color);
+}
+
+std::string NodeStore::Label(int id) const {
+    int index = labelIndex[id];
+    return index == DEFAULT_LABEL ? std::to_string(id) : labelTable[index];
+}
+
+void NodeStore::SetLabel(int id, const std::string& label) {
+    if (label == std::to_string(id)) {
+        labelIndex[id] = DEFAULT_LABEL;
+        return;
+    }
+
+    auto [it, added] = labelLookup.emplace(label, static_cast<int>(labelTable.size()));
+    if (added) labelTable.push_back(label);
+    labelIndex[id] = it->second;
+}
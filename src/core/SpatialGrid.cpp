@@ -0,0 +1,191 @@
+#include "../../include/core/SpatialGrid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+SpatialGrid::SpatialGrid(float cellSize) : cellSize(cellSize) {}
+
+int SpatialGrid::CellCoord(float v) const {
+    return static_cast<int>(std::floor(v / cellSize));
+}
+
+int64_t SpatialGrid::CellKey(int cx, int cy) {
+    return (static_cast<int64_t>(cx) << 32) | static_cast<uint32_t>(cy);
+}
+
+const std::vector<SpatialGrid::Entry>* SpatialGrid::FindCell(int cx, int cy) const {
+    auto it = cells.find(CellKey(cx, cy));
+    return it != cells.end() ? &it->second : nullptr;
+}
+
+void SpatialGrid::Insert(int id, Vector2 position) {
+    int cx = CellCoord(position.x);
+    int cy = CellCoord(position.y);
+    cells[CellKey(cx, cy)].push_back({ id, position });
+
+    if (count == 0) {
+        minCellX = maxCellX = cx;
+        minCellY = maxCellY = cy;
+    } else {
+        minCellX = std::min(minCellX, cx);
+        maxCellX = std::max(maxCellX, cx);
+        minCellY = std::min(minCellY, cy);
+        maxCellY = std::max(maxCellY, cy);
+    }
+    count++;
+}
+
+void SpatialGrid::Remove(int id, Vector2 position) {
+    auto it = cells.find(CellKey(CellCoord(position.x), CellCoord(position.y)));
+    if (it == cells.end()) return;
+
+    std::vector<Entry>& entries = it->second;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].id == id) {
+            entries[i] = entries.back();
+            entries.pop_back();
+            count--;
+            break;
+        }
+    }
+    if (entries.empty()) cells.erase(it);
+}
+
+void SpatialGrid::Move(int id, Vector2 from, Vector2 to) {
+    Remove(id, from);
+    Insert(id, to);
+}
+
+void SpatialGrid::Clear() {
+    cells.clear();
+    count = 0;
+    minCellX = minCellY = 0;
+    maxCellX = maxCellY = -1;
+}
+
+int SpatialGrid::QueryPoint(Vector2 point, float radius) const {
+    int best = -1;
+    float bestDistSq = radius * radius;
+
+    for (int cy = CellCoord(point.y - radius); cy <= CellCoord(point.y + radius); ++cy) {
+        for (int cx = CellCoord(point.x - radius); cx <= CellCoord(point.x + radius); ++cx) {
+            const std::vector<Entry>* cell = FindCell(cx, cy);
+            if (!cell) continue;
+
+            for (const Entry& e : *cell) {
+                float dx = e.position.x - point.x;
+                float dy = e.position.y - point.y;
+                float d = dx * dx + dy * dy;
+                if (d <= bestDistSq) {
+                    bestDistSq = d;
+                    best = e.id;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+template <typename Fn>
+void SpatialGrid::ForEachInBox(Vector2 min, Vector2 max, Fn&& fn) const {
+    if (count == 0) return;
+
+    int x0 = std::max(CellCoord(min.x), minCellX);
+    int x1 = std::min(CellCoord(max.x), maxCellX);
+    int y0 = std::max(CellCoord(min.y), minCellY);
+    int y1 = std::min(CellCoord(max.y), maxCellY);
+    if (x0 > x1 || y0 > y1) return;
+
+    auto visit = [&](const Entry& e) {
+        if (e.position.x >= min.x && e.position.x <= max.x &&
+            e.position.y >= min.y && e.position.y <= max.y) {
+            fn(e);
+        }
+    };
+
+    // A huge box over a sparse grid: walking the occupied cells is cheaper
+    // than probing every empty cell in range.
+    uint64_t span = static_cast<uint64_t>(x1 - x0 + 1) * static_cast<uint64_t>(y1 - y0 + 1);
+    if (span > cells.size()) {
+        for (const auto& [key, entries] : cells) {
+            for (const Entry& e : entries) visit(e);
+        }
+        return;
+    }
+
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            const std::vector<Entry>* cell = FindCell(cx, cy);
+            if (!cell) continue;
+
+            for (const Entry& e : *cell) visit(e);
+        }
+    }
+}
+
+void SpatialGrid::QueryRect(Vector2 min, Vector2 max, std::vector<int>& out) const {
+    ForEachInBox(min, max, [&](const Entry& e) { out.push_back(e.id); });
+}
+
+void SpatialGrid::QueryRadius(Vector2 center, float radius, std::vector<int>& out) const {
+    float radiusSq = radius * radius;
+    ForEachInBox({ center.x - radius, center.y - radius }, { center.x + radius, center.y + radius },
+        [&](const Entry& e) {
+            float dx = e.position.x - center.x;
+            float dy = e.position.y - center.y;
+            if (dx * dx + dy * dy <= radiusSq) out.push_back(e.id);
+        });
+}
+
+int SpatialGrid::Nearest(Vector2 point) const {
+    if (count == 0) return -1;
+
+    int cx = CellCoord(point.x);
+    int cy = CellCoord(point.y);
+
+    int best = -1;
+    float bestDistSq = std::numeric_limits<float>::infinity();
+
+    auto consider = [&](const Entry& e) {
+        float dx = e.position.x - point.x;
+        float dy = e.position.y - point.y;
+        float d = dx * dx + dy * dy;
+        if (d < bestDistSq) {
+            bestDistSq = d;
+            best = e.id;
+        }
+    };
+
+    // Every cell outside the occupied bounding box is empty, so the ring
+    // search never needs to grow past it.
+    int maxRing = std::max({ std::abs(cx - minCellX), std::abs(cx - maxCellX),
+                             std::abs(cy - minCellY), std::abs(cy - maxCellY) });
+
+    size_t probes = 0;
+    for (int ring = 0; ring <= maxRing; ++ring) {
+        // Anything found beyond this ring is at least `ring - 1` cells away.
+        float ringDist = (ring - 1) * cellSize;
+        if (best != -1 && ringDist > 0 && ringDist * ringDist > bestDistSq) break;
+
+        for (int y = cy - ring; y <= cy + ring; ++y) {
+            bool edgeRow = (y == cy - ring || y == cy + ring);
+            int step = edgeRow ? 1 : 2 * ring;
+            for (int x = cx - ring; x <= cx + ring; x += std::max(step, 1)) {
+                const std::vector<Entry>* cell = FindCell(x, y);
+                if (cell) {
+                    for (const Entry& e : *cell) consider(e);
+                }
+
+                // Far from a sparse graph the rings are mostly empty; once
+                // they cost more than a full scan, do the full scan instead.
+                if (++probes > cells.size()) {
+                    for (const auto& [key, entries] : cells) {
+                        for (const Entry& e : entries) consider(e);
+                    }
+                    return best;
+                }
+            }
+        }
+    }
+    return best;
+}
@@ -0,0 +1,61 @@
+#include "../../include/core/ThreadPool.hpp"
+
+ThreadPool::ThreadPool(int threadCount) {
+    if (threadCount <= 0) threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    threadCount = std::max(threadCount, 1);
+
+    for (int worker = 1; worker < threadCount; ++worker) {
+        threads.emplace_back(&ThreadPool::WorkerLoop, this, worker);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) thread.join();
+}
+
+void ThreadPool::Run(const std::function<void(int)>& fn) {
+    if (threads.empty()) {
+        fn(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        jobGeneration++;
+        running = static_cast<int>(threads.size());
+    }
+    wake.notify_all();
+
+    fn(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&] { return running == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::WorkerLoop(int worker) {
+    uint64_t seenGeneration = 0;
+    for (;;) {
+        const std::function<void(int)>* current;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return quit || jobGeneration != seenGeneration; });
+            if (quit) return;
+            seenGeneration = jobGeneration;
+            current = job;
+        }
+
+        (*current)(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--running == 0) finished.notify_one();
+        }
+    }
+}
@@ -1,15 +1,31 @@
 #include "raylib.h"
 #include "raymath.h"
+#include <algorithm>
 #include <memory>  
 #include <string>
 #include <iostream>
 
 #include "../include/core/Graph.hpp"
+#include "../include/core/GraphIO.hpp"
+#include "../include/core/GraphFile.hpp"
+#include "../include/core/GraphImporter.hpp"
+#include "../include/core/ForceLayout.hpp"
 #include "../include/algorithms/Algorithms.hpp"
+#include "../include/algorithms/SolverWorker.hpp"
+#include "../include/algorithms/SearchTrace.hpp"
+#include "../include/ui/Renderer.hpp"
+#include "../include/ui/StepScheduler.hpp"
 
 const int SCREEN_WIDTH = 1200;
 const int SCREEN_HEIGHT = 800;
-const float STEP_DELAY = 0.1f;
+const float MIN_ZOOM = 0.02f;
+const float MAX_ZOOM = 8.0f;
+const char* SNAPSHOT_PATH = "graph.tgv";
+const char* TRACE_PATH = "trace.tgt";
+const float SCRUB_SECONDS = 10.0f;  // holding an arrow sweeps the whole trace in this time
+const float LAYOUT_BUDGET_MS = 12.0f;  // layout time per frame (at least one iteration)
+const size_t LAYOUT_LIVE_NODES = 20000;  // up to this size a running layout is shown every frame
+const double LAYOUT_APPLY_SECONDS = 0.25;  // beyond it, this often
 
 enum class AppState {
     EDITOR,
@@ -18,11 +34,96 @@ enum class AppState {
     FINISHED
 };
 
-int main() {
+// Centers the camera on the graph's bounding box and zooms to fit it.
+static void FitCameraToGraph(Camera2D& camera, const Graph& graph) {
+    camera.offset = { GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f };
+    camera.rotation = 0.0f;
+
+    if (graph.GetNodeCount() == 0) {
+        camera.target = camera.offset;
+        camera.zoom = 1.0f;
+        return;
+    }
+
+    const NodeStore& nodes = graph.GetNodes();
+    const float* xs = nodes.X();
+    const float* ys = nodes.Y();
+    Vector2 lo = { xs[0], ys[0] };
+    Vector2 hi = lo;
+    for (int id = 1; id < nodes.Size(); ++id) {
+        lo = { fminf(lo.x, xs[id]), fminf(lo.y, ys[id]) };
+        hi = { fmaxf(hi.x, xs[id]), fmaxf(hi.y, ys[id]) };
+    }
+
+    float width = hi.x - lo.x + 4 * NODE_RADIUS;
+    float height = hi.y - lo.y + 4 * NODE_RADIUS;
+    camera.target = { (lo.x + hi.x) / 2.0f, (lo.y + hi.y) / 2.0f };
+    camera.zoom = Clamp(fminf(GetScreenWidth() / width, GetScreenHeight() / height), MIN_ZOOM, MAX_ZOOM);
+}
+
+static bool HasExtension(const std::string& path, const char* ext) {
+    size_t len = std::char_traits<char>::length(ext);
+    return path.size() >= len && path.compare(path.size() - len, len, ext) == 0;
+}
+
+static Color SearchEventColor(SearchEventKind kind) {
+    switch (kind) {
+    case SearchEventKind::START:      return COLOR_START;
+    case SearchEventKind::DISCOVERED: return COLOR_FRONTIER;
+    case SearchEventKind::RELAXED:    return COLOR_FRONTIER;
+    case SearchEventKind::SETTLED:    return COLOR_VISITED;
+    case SearchEventKind::PATH:       return COLOR_PATH;
+    case SearchEventKind::BACKWARD_DISCOVERED: return COLOR_BACKWARD_FRONTIER;
+    case SearchEventKind::BACKWARD_SETTLED:    return COLOR_BACKWARD_VISITED;
+    }
+    return COLOR_DEFAULT;
+}
+
+static Color MarkColor(uint8_t mark) {
+    return mark == 0 ? COLOR_DEFAULT : SearchEventColor(MarkToKind(mark));
+}
+
+// GraphViz [graph-file [coords-file]]: .tgv snapshots go through
+// LoadGraphFile, imported formats through GraphImporter, anything else is
+// read as the GraphIO text format.
+static bool LoadGraphFromArgs(int argc, char** argv, Graph& graph) {
+    if (argc < 2) return true;
+
+    std::string error;
+    std::string path = argv[1];
+    if (HasExtension(path, ".tgv")) {
+        if (LoadGraphFile(path, graph, &error)) return true;
+    } else if (DetectImportFormat(path) == ImportFormat::Auto) {
+        if (LoadGraphText(path, graph, &error)) return true;
+    } else {
+        GraphImporter importer(graph);
+        if (importer.Import(path, ImportFormat::Auto, &error) &&
+            (argc < 3 || importer.Import(argv[2], ImportFormat::Auto, &error))) {
+            return true;
+        }
+    }
+
+    std::cerr << path << ": " << error << std::endl;
+    return false;
+}
+
+int main(int argc, char** argv) {
+    SetConfigFlags(FLAG_WINDOW_RESIZABLE);
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Graph Visualizer - C++ & Raylib");
     SetTargetFPS(60);
 
     Graph graph;
+    Renderer renderer;
+
+    Camera2D camera = { { 0, 0 }, { 0, 0 }, 0.0f, 1.0f };
+
+    if (!LoadGraphFromArgs(argc, argv, graph)) {
+        CloseWindow();
+        return 1;
+    }
+    if (graph.GetNodeCount() > 0) {
+        FitCameraToGraph(camera, graph);
+    }
     
     std::unique_ptr<ISolver> solver = nullptr;
     
@@ -33,16 +134,67 @@ int main() {
     int dragSourceId = -1;
     Vector2 currentMousePos = {0, 0};
 
-    float stepTimer = 0.0f;
+    StepScheduler scheduler;
+
+    // Declared after `solver` so it is destroyed (and lets go of it) first.
+    SolverWorker worker;
+    const CsrGraph* runGraph = nullptr;
+
+    // Every run is recorded; once it finishes the player scrubs through it.
+    SearchTrace trace;
+    TracePlayer player;
+
+    // Trees left by finished runs. Space on an unchanged graph, with the same
+    // algorithm and start, walks one back instead of searching again.
+    PathTreeCache treeCache;
+    uint64_t runVersion = 0;
+    bool runFromCache = false;
+    bool treePending = false;
 
     solver = std::make_unique<BfsSolver>();
     std::string currentAlgoName = "BFS";
+    QueueKind queueKind = QueueKind::INDEXED_DARY;
+    HeuristicKind heuristicKind = HeuristicKind::EUCLIDEAN;
+
+    // G lays the graph out a few iterations per frame. Edits made while it
+    // runs restart it from the edited graph.
+    ForceLayout layout;
+    bool layoutRunning = false;
+    uint64_t layoutVersion = 0;
+    double layoutAppliedAt = 0.0;
 
     while (!WindowShouldClose()) {
-        currentMousePos = GetMousePosition();
         float dt = GetFrameTime();
 
+        // Zoom around the cursor, pan with the middle button.
+        float wheel = GetMouseWheelMove();
+        if (wheel != 0.0f) {
+            Vector2 mouseScreen = GetMousePosition();
+            camera.target = GetScreenToWorld2D(mouseScreen, camera);
+            camera.offset = mouseScreen;
+            camera.zoom = Clamp(camera.zoom * expf(0.15f * wheel), MIN_ZOOM, MAX_ZOOM);
+        }
+
+        if (IsMouseButtonDown(MOUSE_BUTTON_MIDDLE)) {
+            Vector2 delta = GetMouseDelta();
+            camera.target.x -= delta.x / camera.zoom;
+            camera.target.y -= delta.y / camera.zoom;
+        }
+
+        if (IsKeyPressed(KEY_M)) scheduler.NextMode();
+        if (IsKeyPressed(KEY_EQUAL) || IsKeyPressed(KEY_KP_ADD)) scheduler.Faster();
+        if (IsKeyPressed(KEY_MINUS) || IsKeyPressed(KEY_KP_SUBTRACT)) scheduler.Slower();
+
+        if (IsKeyPressed(KEY_F)) {
+            FitCameraToGraph(camera, graph);
+        }
+
+        currentMousePos = GetScreenToWorld2D(GetMousePosition(), camera);
+
         if (IsKeyPressed(KEY_R)) {
+            worker.Cancel();
+            player.Detach();
+            layoutRunning = false;
             graph.ClearAll();
             currentState = AppState::EDITOR;
             startNodeId = -1; endNodeId = -1;
@@ -50,30 +202,107 @@ int main() {
         }
 
         if (IsKeyPressed(KEY_C)) {
+            worker.Cancel();
+            player.Detach();
             graph.ResetGraphVisuals();
             currentState = AppState::EDITOR;
         }
 
+        if (currentState == AppState::EDITOR && IsKeyPressed(KEY_S)) {
+            std::string error;
+            if (!SaveGraphFile(SNAPSHOT_PATH, graph, {}, &error)) {
+                std::cerr << error << std::endl;
+            }
+        }
+
+        if (currentState == AppState::EDITOR && IsKeyPressed(KEY_L)) {
+            std::string error;
+            if (LoadGraphFile(SNAPSHOT_PATH, graph, &error)) {
+                layoutRunning = false;
+                startNodeId = -1; endNodeId = -1;
+                dragSourceId = -1;
+                FitCameraToGraph(camera, graph);
+            } else {
+                std::cerr << error << std::endl;
+            }
+        }
+
+        if (currentState == AppState::EDITOR && IsKeyPressed(KEY_G)) {
+            // Stopping keeps the positions reached so far.
+            if (layoutRunning && graph.GetVersion() == layoutVersion) layout.Apply(graph);
+            layoutRunning = !layoutRunning && graph.GetNodeCount() > 1;
+            if (layoutRunning) layout.Begin(graph.GetSnapshot());
+            layoutVersion = graph.GetVersion();
+        }
+
         if (IsKeyPressed(KEY_SPACE)) {
             if (currentState == AppState::EDITOR) {
                 if (startNodeId != -1 && endNodeId != -1) {
                     graph.ResetGraphVisuals();
 
-                    currentState = AppState::RUNNING;
-                    solver->Initialize(&graph, startNodeId, endNodeId);
+                    runGraph = &graph.GetSnapshot();
+                    runVersion = graph.GetVersion();
+                    trace.Begin(runGraph->NodeCount());
+
+                    int endIndex = runGraph->ToDense(endNodeId);
+                    const ShortestPathTree* tree = solver->CanExportTree()
+                        ? treeCache.Find(currentAlgoName, startNodeId, runVersion, endIndex) : nullptr;
+                    runFromCache = tree != nullptr;
+                    treePending = false;
+                    if (tree) {
+                        for (int nodeId : PathTreeCache::TracePath(*runGraph, *tree, endIndex)) {
+                            SearchEvent event = { runGraph->ToDense(nodeId), SearchEventKind::PATH };
+                            trace.OnSearchEvent(event);
+                            runGraph->SetColor(event.node, SearchEventColor(event.kind));
+                        }
+                        currentState = AppState::FINISHED;
+                        player.Attach(trace);
+                        player.Seek(trace.GetEventCount());
+                        player.ConsumeChanges([](int, uint8_t) {});
+                    } else {
+                        currentState = AppState::RUNNING;
+                        worker.Start(*solver, *runGraph, startNodeId, endNodeId);
+                        scheduler.Reset();
+                    }
                 }
             } else if (currentState == AppState::RUNNING) {
                 currentState = AppState::PAUSED;
+                worker.Interrupt();
             } else if (currentState == AppState::PAUSED) {
                 currentState = AppState::RUNNING;
             }
         }
 
         if (currentState == AppState::EDITOR || currentState == AppState::FINISHED) {
+            if (IsKeyPressed(KEY_ONE) || IsKeyPressed(KEY_TWO) || IsKeyPressed(KEY_THREE) || IsKeyPressed(KEY_FOUR) ||
+                IsKeyPressed(KEY_FIVE) || IsKeyPressed(KEY_SIX) || IsKeyPressed(KEY_SEVEN) || IsKeyPressed(KEY_EIGHT) ||
+                IsKeyPressed(KEY_NINE) || IsKeyPressed(KEY_ZERO) || IsKeyPressed(KEY_I) || IsKeyPressed(KEY_Q) ||
+                IsKeyPressed(KEY_H)) {
+                worker.Cancel();
+            }
+            if (IsKeyPressed(KEY_Q)) {
+                queueKind = (queueKind == QueueKind::INDEXED_DARY) ? QueueKind::LAZY_BINARY : QueueKind::INDEXED_DARY;
+                if (currentAlgoName == "Dijkstra") solver = std::make_unique<DijkstraSolver>(queueKind);
+                if (currentAlgoName == "A*")       solver = std::make_unique<AStarSolver>(queueKind, heuristicKind);
+            }
+            if (IsKeyPressed(KEY_H)) {
+                heuristicKind = (heuristicKind == HeuristicKind::EUCLIDEAN) ? HeuristicKind::LANDMARKS : HeuristicKind::EUCLIDEAN;
+                if (currentAlgoName == "A*") solver = std::make_unique<AStarSolver>(queueKind, heuristicKind);
+            }
             if (IsKeyPressed(KEY_ONE))   { solver = std::make_unique<BfsSolver>(); currentAlgoName = "BFS"; }
             if (IsKeyPressed(KEY_TWO))   { solver = std::make_unique<DfsSolver>(); currentAlgoName = "DFS"; }
-            if (IsKeyPressed(KEY_THREE)) { solver = std::make_unique<DijkstraSolver>(); currentAlgoName = "Dijkstra"; }
-            if (IsKeyPressed(KEY_FOUR))  { solver = std::make_unique<AStarSolver>(); currentAlgoName = "A*"; }
+            if (IsKeyPressed(KEY_THREE)) { solver = std::make_unique<DijkstraSolver>(queueKind); currentAlgoName = "Dijkstra"; }
+            if (IsKeyPressed(KEY_FOUR))  { solver = std::make_unique<AStarSolver>(queueKind, heuristicKind); currentAlgoName = "A*"; }
+            // Editor weights are Euclidean lengths, so allow quantization;
+            // graphs with integer weights still run exact.
+            if (IsKeyPressed(KEY_FIVE))  { solver = std::make_unique<RadixDijkstraSolver>(true); currentAlgoName = "Dijkstra (radix)"; }
+            if (IsKeyPressed(KEY_SIX))   { solver = std::make_unique<BidirectionalDijkstraSolver>(); currentAlgoName = "Bidirectional Dijkstra"; }
+            if (IsKeyPressed(KEY_SEVEN)) { solver = std::make_unique<BidirectionalAStarSolver>(); currentAlgoName = "Bidirectional A*"; }
+            if (IsKeyPressed(KEY_EIGHT)) { solver = std::make_unique<ChSolver>(); currentAlgoName = "Contraction Hierarchies"; }
+            if (IsKeyPressed(KEY_NINE)) { solver = std::make_unique<DeltaSteppingSolver>(); currentAlgoName = "Delta-stepping"; }
+            if (IsKeyPressed(KEY_ZERO)) { solver = std::make_unique<ParallelBfsSolver>(); currentAlgoName = "BFS (parallel)"; }
+            // Kept across runs: C, an edit and Space repairs the last search.
+            if (IsKeyPressed(KEY_I))    { solver = std::make_unique<LpaStarSolver>(); currentAlgoName = "LPA* (incremental)"; }
         }
 
         if (currentState == AppState::EDITOR) {
@@ -101,9 +330,8 @@ int main() {
                 if (dragSourceId != -1) {
                     int dragTargetId = graph.GetNodeAtPosition(currentMousePos);
                     if (dragTargetId != -1 && dragTargetId != dragSourceId) {
-                        Node* a = graph.GetNode(dragSourceId);
-                        Node* b = graph.GetNode(dragTargetId);
-                        float weight = Vector2Distance(a->position, b->position);
+                        float weight = Vector2Distance(graph.GetNodePosition(dragSourceId),
+                                                       graph.GetNodePosition(dragTargetId));
                         
                         graph.AddEgde(dragSourceId, dragTargetId, weight);
                     }
@@ -112,66 +340,164 @@ int main() {
             }
         }
 
+        if (currentState != AppState::EDITOR) layoutRunning = false;
+        if (layoutRunning) {
+            if (graph.GetVersion() != layoutVersion) layout.Begin(graph.GetSnapshot());
+            layoutRunning = layout.RunFor(LAYOUT_BUDGET_MS);
+
+            // Applying moves every node and makes the renderer rebuild its
+            // edge cache, which on large graphs costs more than the budget.
+            if (!layoutRunning || graph.GetNodeCount() <= LAYOUT_LIVE_NODES ||
+                GetTime() - layoutAppliedAt >= LAYOUT_APPLY_SECONDS) {
+                layout.Apply(graph);
+                layoutAppliedAt = GetTime();
+            }
+            layoutVersion = graph.GetVersion();
+            if (!layoutRunning) FitCameraToGraph(camera, graph);
+        }
+
         if (currentState == AppState::RUNNING) {
-            stepTimer += dt;
-            if (stepTimer >= STEP_DELAY) {
-                stepTimer = 0.0f;
-                
-                SolverState result = solver->Step();
-                
-                if (result == SolverState::FINISHED_FOUND_PATH) {
-                    currentState = AppState::FINISHED;
-                    
-                    std::vector<int> path = solver->GetPath();
-                    for (int nodeId : path) {
-                        if (Node* n = graph.GetNode(nodeId)) {
-                            n->color = GREEN; 
-                        }
-                    }
-                    
-                } else if (result == SolverState::FINISHED_NO_PATH) {
-                    currentState = AppState::FINISHED;
-                }
+            worker.Grant(scheduler.NextQuota(dt));
+        }
+
+        // Read the state before draining: once it says finished, the run's
+        // last events (the path) are already in the ring.
+        SolverState result = worker.GetState();
+        worker.Drain([&](const SearchEvent& event) {
+            trace.OnSearchEvent(event);
+            runGraph->SetColor(event.node, SearchEventColor(event.kind));
+        });
+
+        if (currentState == AppState::RUNNING &&
+            (result == SolverState::FINISHED_FOUND_PATH || result == SolverState::FINISHED_NO_PATH)) {
+            currentState = AppState::FINISHED;
+
+            // The graph already shows the end state; start the player there.
+            player.Attach(trace);
+            player.Seek(trace.GetEventCount());
+            player.ConsumeChanges([](int, uint8_t) {});
+            treePending = true;
+        }
+
+        // The worker lets go of the solver just after publishing the final
+        // state, so this may take another frame. A Cancel resets the state
+        // and drops the tree.
+        bool runFinished = result == SolverState::FINISHED_FOUND_PATH || result == SolverState::FINISHED_NO_PATH;
+        if (treePending && (currentState != AppState::FINISHED || !runFinished)) treePending = false;
+        if (treePending) {
+            worker.TryInspect([&](ISolver& finished) {
+                ShortestPathTree tree;
+                if (finished.ExportTree(tree)) treeCache.Insert(currentAlgoName, startNodeId, runVersion, std::move(tree));
+                treePending = false;
+            });
+        }
+
+        bool shiftDown = IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT);
+
+        if (currentState == AppState::FINISHED && player.IsAttached()) {
+            // Arrows scrub (Shift: one event per press), Home/End jump.
+            int64_t scrubStep = std::max<int64_t>(1, static_cast<int64_t>(player.GetLength() * dt / SCRUB_SECONDS));
+            if (shiftDown) {
+                if (IsKeyPressed(KEY_LEFT))  player.Skip(-1);
+                if (IsKeyPressed(KEY_RIGHT)) player.Skip(1);
+            } else {
+                if (IsKeyDown(KEY_LEFT))  player.Skip(-scrubStep);
+                if (IsKeyDown(KEY_RIGHT)) player.Skip(scrubStep);
+            }
+            if (IsKeyPressed(KEY_HOME)) player.Seek(0);
+            if (IsKeyPressed(KEY_END))  player.Seek(player.GetLength());
+
+            player.ConsumeChanges([&](int u, uint8_t mark) {
+                runGraph->SetColor(u, MarkColor(mark));
+            });
+
+            if (IsKeyPressed(KEY_T) && !shiftDown) {
+                std::string error;
+                if (!trace.Save(TRACE_PATH, &error)) std::cerr << error << std::endl;
+            }
+        }
+
+        // Shift+T replays a saved trace of this graph without running anything.
+        if (currentState == AppState::EDITOR && IsKeyPressed(KEY_T) && shiftDown) {
+            std::string error;
+            const CsrGraph& snapshot = graph.GetSnapshot();
+            if (!trace.Load(TRACE_PATH, &error)) {
+                std::cerr << error << std::endl;
+            } else if (trace.GetNodeCount() != snapshot.NodeCount()) {
+                std::cerr << TRACE_PATH << ": recorded on a graph with " << trace.GetNodeCount()
+                          << " nodes, this one has " << snapshot.NodeCount() << std::endl;
+                trace.Clear();
+            } else {
+                runGraph = &snapshot;
+                player.Attach(trace);
+                player.Seek(trace.GetEventCount());
+                currentState = AppState::FINISHED;
             }
         }
 
         BeginDrawing();
         ClearBackground(RAYWHITE);
 
-        graph.Draw(GetFontDefault());
+        renderer.Draw(graph, GetFontDefault(), camera);
+
+        BeginMode2D(camera);
 
         if (startNodeId != -1) {
-            Node* n = graph.GetNode(startNodeId);
-            DrawCircleLines(n->position.x, n->position.y, NODE_RADIUS + 5, GREEN);
-            DrawText("START", n->position.x - 20, n->position.y - 40, 10, GREEN);
+            Vector2 p = graph.GetNodePosition(startNodeId);
+            DrawCircleLines(p.x, p.y, NODE_RADIUS + 5, GREEN);
+            DrawText("START", p.x - 20, p.y - 40, 10, GREEN);
         }
         if (endNodeId != -1) {
-            Node* n = graph.GetNode(endNodeId);
-            DrawCircleLines(n->position.x, n->position.y, NODE_RADIUS + 5, RED);
-            DrawText("END", n->position.x - 15, n->position.y - 40, 10, RED);
+            Vector2 p = graph.GetNodePosition(endNodeId);
+            DrawCircleLines(p.x, p.y, NODE_RADIUS + 5, RED);
+            DrawText("END", p.x - 15, p.y - 40, 10, RED);
         }
 
         if (dragSourceId != -1) {
-            Node* n = graph.GetNode(dragSourceId);
-            DrawLineEx(n->position, currentMousePos, 2.0f, GRAY);
+            DrawLineEx(graph.GetNodePosition(dragSourceId), currentMousePos, 2.0f, GRAY);
         }
 
+        // Overlays read solver state, so they only show while the worker
+        // is parked (paused, finished, or between slow steps).
         if (currentState != AppState::EDITOR) {
-            solver->DrawDebug(GetFontDefault());
+            RaylibDebugCanvas canvas(GetFontDefault());
+            worker.TryInspect([&](ISolver& inspected) { inspected.DrawDebug(canvas); });
         }
 
-        DrawRectangle(0, 0, SCREEN_WIDTH, 50, Fade(LIGHTGRAY, 0.8f));
-        DrawText(TextFormat("Mode: %s | Algo: %s", 
+        EndMode2D();
+
+        DrawRectangle(0, 0, GetScreenWidth(), 50, Fade(LIGHTGRAY, 0.8f));
+        DrawText(TextFormat("Mode: %s | Algo: %s%s%s%s", 
             (currentState == AppState::EDITOR ? "EDITOR" : "RUNNING"), 
-            currentAlgoName.c_str()), 10, 15, 20, DARKGRAY);
+            currentAlgoName.c_str(), queueKind == QueueKind::LAZY_BINARY ? " (lazy)" : "",
+            currentAlgoName == "A*" && heuristicKind == HeuristicKind::LANDMARKS ? " (landmarks)" : "",
+            currentState == AppState::FINISHED && runFromCache ? " (cached tree)" : ""), 10, 8, 20, DARKGRAY);
+        if (player.IsAttached()) {
+            DrawText(TextFormat("Trace: %llu / %llu events, %.1f KiB",
+                static_cast<unsigned long long>(player.GetPosition()),
+                static_cast<unsigned long long>(player.GetLength()),
+                trace.GetByteSize() / 1024.0), 10, 32, 10, DARKGRAY);
+
+            float progress = player.GetLength() > 0 ? static_cast<float>(player.GetPosition()) / player.GetLength() : 1.0f;
+            DrawRectangle(0, 48, static_cast<int>(GetScreenWidth() * progress), 2, DARKGRAY);
+        } else if (layoutRunning) {
+            DrawText(TextFormat("Layout: level %d of %d, %d iterations",
+                layout.GetLevelCount() - layout.GetLevel(), layout.GetLevelCount(), layout.GetIteration()), 10, 32, 10, DARKGRAY);
+        } else {
+            DrawText(TextFormat("Speed: %s | %d expanded",
+                scheduler.Describe().c_str(), worker.GetExpandedCount()), 10, 32, 10, DARKGRAY);
+        }
         
-        DrawText("L-Click: Adicionar nó | R-Drag: Vértice | Space: Executar | R: Reset | 1-4: Trocar algoritmo", 
-            350, 18, 10, DARKGRAY);
+        DrawText("L-Click: Adicionar nó | R-Drag: Vértice | Space: Executar | R: Reset | 0-9/I: Trocar algoritmo | Roda/M-Drag: Zoom/Mover | F: Enquadrar | S/L: Salvar/Carregar graph.tgv", 
+            350, 12, 10, DARKGRAY);
+        DrawText("M: Modo de velocidade | +/-: Mais rápido/lento | Q: Heap indexado/lazy | H: Heurística A* (reta/landmarks) | Setas/Home/End: Rever busca | T/Shift+T: Salvar/Carregar trace.tgt | G: Layout automático", 
+            350, 28, 10, DARKGRAY);
 
         EndDrawing();
     }
 
     // 4. CLEANUP
+    renderer.Unload();
     CloseWindow();
     return 0;
 }
\ No newline at end of file
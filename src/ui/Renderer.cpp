@@ -0,0 +1,179 @@
+#include "../../include/ui/Renderer.hpp"
+#include "rlgl.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <unordered_map>
+
+constexpr float EDGE_THICKNESS = 2.0f;
+
+// Triangles submitted per rlBegin/rlEnd; keeps each chunk inside rlgl's batch.
+constexpr int EDGES_PER_CHUNK = 1024;
+
+// Below this zoom text is unreadable, so labels are skipped entirely.
+constexpr float LABEL_MIN_ZOOM = 0.5f;
+
+Rectangle GetCameraView(const Camera2D& camera) {
+    Vector2 topLeft = GetScreenToWorld2D({ 0, 0 }, camera);
+    Vector2 bottomRight = GetScreenToWorld2D({ (float)GetScreenWidth(), (float)GetScreenHeight() }, camera);
+    return { topLeft.x, topLeft.y, bottomRight.x - topLeft.x, bottomRight.y - topLeft.y };
+}
+
+static bool SameCamera(const Camera2D& a, const Camera2D& b) {
+    return a.offset.x == b.offset.x && a.offset.y == b.offset.y &&
+           a.target.x == b.target.x && a.target.y == b.target.y &&
+           a.rotation == b.rotation && a.zoom == b.zoom;
+}
+
+void Renderer::RebuildEdgeCache(const Graph& graph) {
+    const auto& nodes = graph.GetNodes();
+
+    edges.clear();
+
+    // Unordered pair -> weight already emitted. AddEgde stores a
+    // bidirectional edge as two directed ones with the same weight.
+    std::unordered_map<uint64_t, float> emitted;
+
+    for (int sourceId = 0; sourceId < nodes.Size(); ++sourceId) {
+        for (const auto& edge : graph.GetNeighbors(sourceId)) {
+            if (!nodes.Contains(edge.targetNodeId)) continue;
+
+            int lo = std::min(sourceId, edge.targetNodeId);
+            int hi = std::max(sourceId, edge.targetNodeId);
+            uint64_t key = (static_cast<uint64_t>(lo) << 32) | static_cast<uint32_t>(hi);
+
+            auto seen = emitted.find(key);
+            if (seen != emitted.end() && seen->second == edge.weight) continue;
+            emitted[key] = edge.weight;
+
+            char buff[16];
+            snprintf(buff, sizeof(buff), "%.1f", edge.weight);
+            edges.push_back({ nodes.Position(sourceId), nodes.Position(edge.targetNodeId), buff });
+        }
+    }
+
+    cachedGraph = &graph;
+    cachedVersion = graph.GetVersion();
+}
+
+void Renderer::DrawEdgeVertices() const {
+    const size_t chunkVertices = EDGES_PER_CHUNK * 6;
+
+    for (size_t first = 0; first < edgeVertices.size(); first += chunkVertices) {
+        size_t last = std::min(edgeVertices.size(), first + chunkVertices);
+
+        rlCheckRenderBatchLimit(static_cast<int>(last - first));
+        rlBegin(RL_TRIANGLES);
+        rlColor4ub(BLACK.r, BLACK.g, BLACK.b, BLACK.a);
+        for (size_t i = first; i < last; ++i) {
+            rlVertex2f(edgeVertices[i].x, edgeVertices[i].y);
+        }
+        rlEnd();
+    }
+}
+
+void Renderer::RenderStaticLayer(Font font, const Camera2D& camera, Rectangle view) {
+    int width = GetScreenWidth();
+    int height = GetScreenHeight();
+    if (staticLayer.id == 0 || staticLayer.texture.width != width || staticLayer.texture.height != height) {
+        if (staticLayer.id != 0) UnloadRenderTexture(staticLayer);
+        staticLayer = LoadRenderTexture(width, height);
+    }
+
+    // Cull against the view, then build this layer's single vertex buffer.
+    edgeVertices.clear();
+    std::vector<const EdgeSegment*> labeled;
+    bool drawLabels = camera.zoom >= LABEL_MIN_ZOOM;
+
+    for (const EdgeSegment& edge : edges) {
+        float minX = std::min(edge.a.x, edge.b.x), maxX = std::max(edge.a.x, edge.b.x);
+        float minY = std::min(edge.a.y, edge.b.y), maxY = std::max(edge.a.y, edge.b.y);
+        if (maxX < view.x || minX > view.x + view.width || maxY < view.y || minY > view.y + view.height) {
+            continue;
+        }
+
+        float dx = edge.b.x - edge.a.x;
+        float dy = edge.b.y - edge.a.y;
+        float length = std::sqrt(dx * dx + dy * dy);
+        if (length > 0.0f) {
+            float nx = -dy / length * (EDGE_THICKNESS / 2.0f);
+            float ny = dx / length * (EDGE_THICKNESS / 2.0f);
+
+            Vector2 a0 = { edge.a.x + nx, edge.a.y + ny };
+            Vector2 a1 = { edge.a.x - nx, edge.a.y - ny };
+            Vector2 b0 = { edge.b.x + nx, edge.b.y + ny };
+            Vector2 b1 = { edge.b.x - nx, edge.b.y - ny };
+
+            // Same winding as DrawLineEx, so backface culling keeps them.
+            edgeVertices.insert(edgeVertices.end(), { b1, a1, a0, b0, b1, a0 });
+        }
+
+        if (drawLabels) labeled.push_back(&edge);
+    }
+
+    BeginTextureMode(staticLayer);
+    ClearBackground(BLANK);
+    BeginMode2D(camera);
+
+    DrawEdgeVertices();
+
+    for (const EdgeSegment* edge : labeled) {
+        Vector2 mid = { (edge->a.x + edge->b.x) / 2.0f, (edge->a.y + edge->b.y) / 2.0f };
+        DrawTextEx(font, edge->label.c_str(), mid, 12, 1, DARKGRAY);
+    }
+
+    EndMode2D();
+    EndTextureMode();
+
+    layerVersion = cachedVersion;
+    layerCamera = camera;
+}
+
+void Renderer::Draw(const Graph& graph, Font font, const Camera2D& camera) {
+    if (cachedGraph != &graph || cachedVersion != graph.GetVersion()) {
+        RebuildEdgeCache(graph);
+    }
+
+    Rectangle view = GetCameraView(camera);
+
+    if (staticLayer.id == 0 || layerVersion != cachedVersion || !SameCamera(layerCamera, camera) ||
+        staticLayer.texture.width != GetScreenWidth() || staticLayer.texture.height != GetScreenHeight()) {
+        RenderStaticLayer(font, camera, view);
+    }
+
+    // Render textures are stored bottom-up, hence the negative height.
+    DrawTextureRec(staticLayer.texture,
+        { 0, 0, (float)staticLayer.texture.width, -(float)staticLayer.texture.height },
+        { 0, 0 }, WHITE);
+
+    std::vector<int> visibleNodes = graph.GetNodesInRect(
+        { view.x - NODE_RADIUS, view.y - NODE_RADIUS },
+        { view.x + view.width + NODE_RADIUS, view.y + view.height + NODE_RADIUS });
+
+    bool drawLabels = camera.zoom >= LABEL_MIN_ZOOM;
+    const auto& nodes = graph.GetNodes();
+
+    BeginMode2D(camera);
+    for (int id : visibleNodes) {
+        Vector2 position = nodes.Position(id);
+        DrawCircleV(position, NODE_RADIUS, nodes.GetColor(id));
+        DrawCircleLines(position.x, position.y, NODE_RADIUS, BLACK);
+        if (drawLabels) {
+            DrawTextEx(font, nodes.Label(id).c_str(), 
+                      { position.x - 5, position.y - 10 }, 
+                      20, 1, WHITE);
+        }
+    }
+    EndMode2D();
+}
+
+void Renderer::Unload() {
+    if (staticLayer.id != 0) {
+        UnloadRenderTexture(staticLayer);
+        staticLayer = {};
+    }
+}
+
+void RaylibDebugCanvas::DrawLabel(const char* text, Vector2 position, float fontSize, Color color) {
+    DrawTextEx(font, text, position, fontSize, 1, color);
+}
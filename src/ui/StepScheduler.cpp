@@ -0,0 +1,93 @@
+#include "../../include/ui/StepScheduler.hpp"
+#include <algorithm>
+#include <cstdio>
+
+constexpr float MIN_STEP_DELAY = 0.005f;
+constexpr float MAX_STEP_DELAY = 1.0f;
+constexpr int MAX_STEPS_PER_FRAME = 1 << 20;
+constexpr float MIN_BUDGET_MS = 0.25f;
+constexpr float MAX_BUDGET_MS = 1000.0f / 60.0f;
+
+StepQuota StepScheduler::NextQuota(float dt) {
+    StepQuota quota;
+
+    switch (mode) {
+    case StepMode::FIXED_DELAY:
+        timer += dt;
+        if (timer >= stepDelay) {
+            timer = 0.0f;
+            quota.steps = 1;
+        }
+        break;
+
+    case StepMode::STEPS_PER_FRAME:
+        quota.steps = stepsPerFrame;
+        break;
+
+    case StepMode::TIME_BUDGET:
+        quota.steps = StepQuota::UNLIMITED_STEPS;
+        quota.milliseconds = budgetMs;
+        break;
+
+    case StepMode::RUN_TO_COMPLETION:
+        quota.steps = StepQuota::UNLIMITED_STEPS;
+        break;
+    }
+
+    return quota;
+}
+
+void StepScheduler::Reset() {
+    timer = 0.0f;
+}
+
+void StepScheduler::SetMode(StepMode newMode) {
+    mode = newMode;
+    Reset();
+}
+
+void StepScheduler::NextMode() {
+    switch (mode) {
+    case StepMode::FIXED_DELAY:       SetMode(StepMode::STEPS_PER_FRAME); break;
+    case StepMode::STEPS_PER_FRAME:   SetMode(StepMode::TIME_BUDGET); break;
+    case StepMode::TIME_BUDGET:       SetMode(StepMode::RUN_TO_COMPLETION); break;
+    case StepMode::RUN_TO_COMPLETION: SetMode(StepMode::FIXED_DELAY); break;
+    }
+}
+
+void StepScheduler::Faster() {
+    switch (mode) {
+    case StepMode::FIXED_DELAY:     stepDelay = std::max(stepDelay / 2.0f, MIN_STEP_DELAY); break;
+    case StepMode::STEPS_PER_FRAME: stepsPerFrame = std::min(stepsPerFrame * 2, MAX_STEPS_PER_FRAME); break;
+    case StepMode::TIME_BUDGET:     budgetMs = std::min(budgetMs * 2.0f, MAX_BUDGET_MS); break;
+    case StepMode::RUN_TO_COMPLETION: break;
+    }
+}
+
+void StepScheduler::Slower() {
+    switch (mode) {
+    case StepMode::FIXED_DELAY:     stepDelay = std::min(stepDelay * 2.0f, MAX_STEP_DELAY); break;
+    case StepMode::STEPS_PER_FRAME: stepsPerFrame = std::max(stepsPerFrame / 2, 1); break;
+    case StepMode::TIME_BUDGET:     budgetMs = std::max(budgetMs / 2.0f, MIN_BUDGET_MS); break;
+    case StepMode::RUN_TO_COMPLETION: break;
+    }
+}
+
+std::string StepScheduler::Describe() const {
+    char text[64];
+    switch (mode) {
+    case StepMode::FIXED_DELAY:
+        std::snprintf(text, sizeof(text), "1 step / %.3f s", stepDelay);
+        break;
+    case StepMode::STEPS_PER_FRAME:
+        std::snprintf(text, sizeof(text), "%d steps / frame", stepsPerFrame);
+        break;
+    case StepMode::TIME_BUDGET:
+        std::snprintf(text, sizeof(text), "budget %.2f ms / frame", budgetMs);
+        break;
+    case StepMode::RUN_TO_COMPLETION:
+        std::snprintf(text, sizeof(text), "run to completion");
+        break;
+    }
+    return text;
+}